@@ -0,0 +1,550 @@
+/*
+ * INFO:
+ *
+ *  Microbenchmarks for the camera.h hot paths
+ *
+ *  Built once per camera_math.h backend (see bench/CMakeLists.txt).
+ *  Every case prints one JSON object per line:
+ *   {"backend": "default", "case": "view_matrix/free", "cameras": 1024, "ns_per_call": 41.2, "calls_per_second": 24271844.6}
+ *
+ *  Usage: camera_bench_<backend> [--min-time-ms <ms>] [--cameras <count>] [<case filter>]
+ *   Only cases containing <case filter> are run.
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#define CAMERA_IMPLEMENTATION
+#include "camera.h"
+#define CAMERA_INTEREST_IMPLEMENTATION
+#include "camera_interest.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifndef CAMERA_BENCH_BACKEND
+#define CAMERA_BENCH_BACKEND "unknown"
+#endif
+
+/* Setup */
+
+static const float bench_pi = 3.14159265358979f;
+
+static double bench_min_time_ms = 200.0;
+static uint32_t bench_cameras = 1024;
+static const char* bench_filter = NULL;
+
+// Keeps results alive, so the compiler can not drop the benchmarked calls
+static volatile float bench_sink;
+
+// Deterministic pseudo random input in [-1; 1]
+static uint32_t bench_seed = 0x12345678u;
+static float bench_random()
+{
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    return (float)(bench_seed >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+static Camera bench_camera(uint32_t _mode)
+{
+    Camera cam = camera_init();
+    cam.mode = _mode;
+    cam.target_distance = (_mode & CAMERA_MODE_MOVE_IN_WORLDPLANE) ? 0.0f : 5.0f;
+    cam.minPitch = -bench_pi / 2.0f;
+    cam.maxPitch = bench_pi / 2.0f;
+    cam.minYaw = -bench_pi / 2.0f;
+    cam.maxYaw = bench_pi / 2.0f;
+    cam.minRoll = -bench_pi / 4.0f;
+    cam.maxRoll = bench_pi / 4.0f;
+    return cam;
+}
+
+// Small per-frame input, so clamping is exercised without pinning every camera at its limits
+struct BenchInput
+{
+    CameraVec3 movement;
+    CameraVec3 rotation;
+};
+
+static std::vector<BenchInput> bench_inputs(uint32_t _count)
+{
+    std::vector<BenchInput> inputs;
+    inputs.reserve(_count);
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+        BenchInput input;
+        input.movement = cm_init_vec3(bench_random() * 0.1f, bench_random() * 0.1f, bench_random() * 0.1f);
+        input.rotation = cm_init_vec3(bench_random() * 0.02f, bench_random() * 0.02f, bench_random() * 0.02f);
+        inputs.push_back(input);
+    }
+    return inputs;
+}
+
+/* Measurement */
+
+// Run _pass (which performs _calls calls) until bench_min_time_ms elapsed and report the fastest pass
+template <typename Pass>
+static void bench_run(const char* _case, uint32_t _calls, Pass _pass)
+{
+    if (bench_filter != NULL && std::strstr(_case, bench_filter) == NULL)
+    {
+        return;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+
+    _pass(); // Warm up caches and branch predictors
+
+    double best_ns = 1e300;
+    double total_ms = 0.0;
+    while (total_ms < bench_min_time_ms)
+    {
+        const Clock::time_point start = Clock::now();
+        _pass();
+        const Clock::time_point end = Clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        best_ns = ns < best_ns ? ns : best_ns;
+        total_ms += ns / 1e6;
+    }
+
+    const double ns_per_call = best_ns / _calls;
+    std::printf("{\"backend\": \"%s\", \"case\": \"%s\", \"cameras\": %u, \"ns_per_call\": %.3f, \"calls_per_second\": %.1f}\n",
+        CAMERA_BENCH_BACKEND, _case, bench_cameras, ns_per_call, 1e9 / ns_per_call);
+    std::fflush(stdout);
+}
+
+/* Cases */
+
+// _update is camera_view_matrix(..) or one of its mode specializations
+template <typename Update>
+static void bench_view_matrix(const char* _case, uint32_t _mode, Update _update)
+{
+    std::vector<Camera> cams(bench_cameras, bench_camera(_mode));
+    const std::vector<BenchInput> inputs = bench_inputs(bench_cameras);
+    std::vector<float> matrices(16 * (size_t)bench_cameras);
+
+    bench_run(_case, bench_cameras, [&]() {
+        for (uint32_t i = 0; i < bench_cameras; ++i)
+        {
+            camera_rotate(&cams[i], inputs[i].rotation);
+            camera_move(&cams[i], inputs[i].movement);
+            _update(&cams[i], &matrices[16 * (size_t)i]);
+        }
+        bench_sink = matrices[12];
+    });
+}
+
+// Cameras without pending changes take the early-out path
+static void bench_view_matrix_idle(const char* _case, uint32_t _mode)
+{
+    std::vector<Camera> cams(bench_cameras, bench_camera(_mode));
+    std::vector<float> matrices(16 * (size_t)bench_cameras);
+
+    bench_run(_case, bench_cameras, [&]() {
+        for (uint32_t i = 0; i < bench_cameras; ++i)
+        {
+            camera_view_matrix(&cams[i], &matrices[16 * (size_t)i]);
+        }
+        bench_sink = matrices[12];
+    });
+}
+
+// Viewports with sparse input, only the dirty cameras are updated
+static void bench_view_matrix_dirty(const char* _case, uint32_t _mode)
+{
+    std::vector<Camera> cams(bench_cameras, bench_camera(_mode));
+    const std::vector<BenchInput> inputs = bench_inputs(bench_cameras);
+    std::vector<float> matrices(16 * (size_t)bench_cameras);
+
+    uint32_t frame = 0;
+    bench_run(_case, bench_cameras, [&]() {
+        // One camera in 64 receives input per frame
+        for (uint32_t i = frame++ % 64; i < bench_cameras; i += 64)
+        {
+            camera_rotate(&cams[i], inputs[i].rotation);
+        }
+        for (uint32_t i = 0; i < bench_cameras; ++i)
+        {
+            if (cams[i].dirty)
+            {
+                camera_view_matrix(&cams[i], &matrices[16 * (size_t)i]);
+            }
+        }
+        bench_sink = matrices[12];
+    });
+}
+
+// _update is camera_view_matrix_batch(..) or one of its mode specializations
+template <typename Update>
+static void bench_view_matrix_batch(const char* _case, uint32_t _mode, Update _update)
+{
+    std::vector<unsigned char> memory(camera_pool_memory_size(bench_cameras) + CAMERA_POOL_ALIGNMENT);
+    void* aligned = (void*)(((uintptr_t)memory.data() + CAMERA_POOL_ALIGNMENT - 1) & ~(uintptr_t)(CAMERA_POOL_ALIGNMENT - 1));
+    CameraPool pool = camera_pool_init(aligned, bench_cameras);
+
+    const Camera cam = bench_camera(_mode);
+    for (uint32_t i = 0; i < bench_cameras; ++i)
+    {
+        camera_pool_add(&pool, &cam);
+    }
+    const std::vector<BenchInput> inputs = bench_inputs(bench_cameras);
+    std::vector<float> matrices(16 * (size_t)bench_cameras);
+
+    bench_run(_case, bench_cameras, [&]() {
+        for (uint32_t i = 0; i < bench_cameras; ++i)
+        {
+            camera_pool_rotate(&pool, i, inputs[i].rotation);
+            camera_pool_move(&pool, i, inputs[i].movement);
+        }
+        _update(&pool, matrices.data());
+        bench_sink = matrices[12];
+    });
+}
+
+// Registry of interleaved modes, regrouped and updated group by group with the mode specializations
+static void bench_registry_grouped(const char* _case)
+{
+    std::vector<unsigned char> memory(camera_registry_memory_size(bench_cameras) + CAMERA_POOL_ALIGNMENT);
+    void* aligned = (void*)(((uintptr_t)memory.data() + CAMERA_POOL_ALIGNMENT - 1) & ~(uintptr_t)(CAMERA_POOL_ALIGNMENT - 1));
+    CameraRegistry registry = camera_registry_init(aligned, bench_cameras);
+
+    const uint32_t modes[3] = { CAMERA_MODE_FREE, CAMERA_MODE_FIRST_PERSON, CAMERA_MODE_ORBITAL };
+    for (uint32_t i = 0; i < bench_cameras; ++i)
+    {
+        const Camera cam = bench_camera(modes[i % 3]);
+        camera_registry_create(&registry, &cam);
+    }
+    const std::vector<BenchInput> inputs = bench_inputs(bench_cameras);
+    std::vector<float> matrices(16 * (size_t)bench_cameras);
+
+    bench_run(_case, bench_cameras, [&]() {
+        CameraPool* pool = &registry.pool;
+        for (uint32_t i = 0; i < pool->count; ++i)
+        {
+            camera_pool_rotate(pool, i, inputs[i].rotation);
+            camera_pool_move(pool, i, inputs[i].movement);
+        }
+
+        const uint32_t groups = camera_registry_compact(&registry);
+        for (uint32_t g = 0; g < groups; ++g)
+        {
+            const CameraRegistryGroup group = registry.groups[g];
+            switch (group.mode)
+            {
+            case CAMERA_MODE_FREE: camera_pool_update<CAMERA_MODE_FREE>(pool, group.begin, group.end, matrices.data()); break;
+            case CAMERA_MODE_FIRST_PERSON: camera_pool_update<CAMERA_MODE_FIRST_PERSON>(pool, group.begin, group.end, matrices.data()); break;
+            case CAMERA_MODE_ORBITAL: camera_pool_update<CAMERA_MODE_ORBITAL>(pool, group.begin, group.end, matrices.data()); break;
+            default: camera_pool_update(pool, group.begin, group.end, matrices.data()); break;
+            }
+        }
+        bench_sink = matrices[12];
+    });
+}
+
+// Render frames between two simulation steps
+static void bench_view_matrix_interpolated(const char* _case, uint32_t _mode)
+{
+    std::vector<Camera> cams(bench_cameras, bench_camera(_mode));
+    const std::vector<BenchInput> inputs = bench_inputs(bench_cameras);
+    std::vector<float> matrices(16 * (size_t)bench_cameras);
+    for (uint32_t i = 0; i < bench_cameras; ++i)
+    {
+        camera_rotate(&cams[i], inputs[i].rotation);
+        camera_move(&cams[i], inputs[i].movement);
+        camera_view_matrix(&cams[i], &matrices[16 * (size_t)i]);
+    }
+
+    float alpha = 0.0f;
+    bench_run(_case, bench_cameras, [&]() {
+        alpha = alpha < 0.75f ? alpha + 0.25f : 0.0f;
+        for (uint32_t i = 0; i < bench_cameras; ++i)
+        {
+            camera_view_matrix_interpolated(&cams[i], alpha, &matrices[16 * (size_t)i]);
+        }
+        bench_sink = matrices[12];
+    });
+}
+
+// Occlusion query against a wall in front of every other camera
+static void bench_boom_query(void*, const CameraBoomRay* _rays, uint32_t _count, float* _out_distances)
+{
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+        _out_distances[i] = (i & 1) ? _rays[i].length * 0.5f : _rays[i].length;
+    }
+}
+
+// Orbital pool updated, then its boom results of last frame applied and the next ones requested
+static void bench_boom_batch(const char* _case)
+{
+    std::vector<unsigned char> memory(camera_pool_memory_size(bench_cameras) + CAMERA_POOL_ALIGNMENT);
+    void* aligned = (void*)(((uintptr_t)memory.data() + CAMERA_POOL_ALIGNMENT - 1) & ~(uintptr_t)(CAMERA_POOL_ALIGNMENT - 1));
+    CameraPool pool = camera_pool_init(aligned, bench_cameras);
+
+    const Camera cam = bench_camera(CAMERA_MODE_ORBITAL);
+    for (uint32_t i = 0; i < bench_cameras; ++i)
+    {
+        camera_pool_add(&pool, &cam);
+    }
+    const std::vector<BenchInput> inputs = bench_inputs(bench_cameras);
+    std::vector<float> matrices(16 * (size_t)bench_cameras);
+    std::vector<CameraBoomRay> rays(bench_cameras);
+    std::vector<float> hits(bench_cameras, 1e9f);
+    const CameraBoom boom = camera_boom(0.2f, 0.5f, 0.0f, 0.3f, 1.0f / 60.0f);
+
+    bench_run(_case, bench_cameras, [&]() {
+        for (uint32_t i = 0; i < bench_cameras; ++i)
+        {
+            camera_pool_rotate(&pool, i, inputs[i].rotation);
+        }
+        camera_boom_apply_batch(&pool, &boom, hits.data());
+        camera_view_matrix_batch(&pool, matrices.data());
+        camera_boom_request_batch(&pool, &boom, rays.data(), hits.data(), bench_boom_query, NULL);
+        bench_sink = matrices[12];
+    });
+}
+
+static void bench_look_at(const char* _case)
+{
+    std::vector<Camera> cams(bench_cameras, bench_camera(CAMERA_MODE_FREE));
+    std::vector<CameraVec3> forwards;
+    forwards.reserve(bench_cameras);
+    for (uint32_t i = 0; i < bench_cameras; ++i)
+    {
+        forwards.push_back(cm_normalizeVec3(cm_init_vec3(bench_random(), bench_random() * 0.5f, bench_random() + 2.0f)));
+    }
+
+    bench_run(_case, bench_cameras, [&]() {
+        for (uint32_t i = 0; i < bench_cameras; ++i)
+        {
+            camera_look_at(&cams[i], forwards[i], CAMERA_WORLD_UP);
+        }
+        bench_sink = cams[bench_cameras - 1].orientation.w;
+    });
+}
+
+static void bench_look_at_batch(const char* _case)
+{
+    std::vector<float> fx(bench_cameras), fy(bench_cameras), fz(bench_cameras);
+    std::vector<float> ux(bench_cameras, CAMERA_WORLD_UP.x), uy(bench_cameras, CAMERA_WORLD_UP.y), uz(bench_cameras, CAMERA_WORLD_UP.z);
+    std::vector<float> qx(bench_cameras), qy(bench_cameras), qz(bench_cameras), qw(bench_cameras);
+    for (uint32_t i = 0; i < bench_cameras; ++i)
+    {
+        const CameraVec3 forward = cm_normalizeVec3(cm_init_vec3(bench_random(), bench_random() * 0.5f, bench_random() + 2.0f));
+        fx[i] = forward.x;
+        fy[i] = forward.y;
+        fz[i] = forward.z;
+    }
+
+    bench_run(_case, bench_cameras, [&]() {
+        camera_look_at_batch(fx.data(), fy.data(), fz.data(), ux.data(), uy.data(), uz.data(), bench_cameras,
+            qx.data(), qy.data(), qz.data(), qw.data());
+        bench_sink = qw[bench_cameras - 1];
+    });
+}
+
+static void bench_lod_select(const char* _case)
+{
+    Camera cam = bench_camera(CAMERA_MODE_FREE);
+    float matrix[16];
+    camera_view_matrix(&cam, matrix);
+
+    const CameraProjection projection = camera_projection_perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f, 0);
+    const float thresholds[3] = { 200.0f, 50.0f, 10.0f };
+    const CameraLod lod = camera_lod(thresholds, 4, 0.1f);
+
+    std::vector<float> x(bench_cameras), y(bench_cameras), z(bench_cameras), radius(bench_cameras);
+    std::vector<float> distanceSq(bench_cameras), pixels(bench_cameras);
+    std::vector<uint8_t> levels(bench_cameras, 0);
+    for (uint32_t i = 0; i < bench_cameras; ++i)
+    {
+        x[i] = bench_random() * 100.0f;
+        y[i] = bench_random() * 10.0f;
+        z[i] = bench_random() * 100.0f + 100.0f;
+        radius[i] = bench_random() + 1.5f;
+    }
+
+    bench_run(_case, bench_cameras, [&]() {
+        camera_lod_select(&cam, &projection, 1080.0f, &lod, x.data(), y.data(), z.data(), radius.data(), bench_cameras,
+            distanceSq.data(), pixels.data(), levels.data());
+        bench_sink = pixels[bench_cameras - 1];
+    });
+}
+
+// 64 players spread over a 1 km square, bench_cameras * 16 entities
+//  _moving re-inserts every camera per update, otherwise the visible entities of every camera are queried.
+static void bench_interest(const char* _case, bool _moving)
+{
+    const uint32_t players = 64;
+    const uint32_t entities = bench_cameras * 16;
+    const CameraProjection projection = camera_projection_perspective(1.2f, 16.0f / 9.0f, 0.1f, 150.0f, 0);
+
+    std::vector<Camera> cams(players, bench_camera(CAMERA_MODE_FIRST_PERSON));
+    std::vector<float> x(entities), y(entities), z(entities), radius(entities);
+    for (uint32_t k = 0; k < players; ++k)
+    {
+        cams[k].target_position = cm_init_vec3(bench_random() * 500.0f, 2.0f, bench_random() * 500.0f);
+        camera_rotate(&cams[k], cm_init_vec3(0.0f, bench_random() * bench_pi / 2.0f, 0.0f));
+    }
+    for (uint32_t i = 0; i < entities; ++i)
+    {
+        x[i] = bench_random() * 500.0f;
+        y[i] = bench_random() * 10.0f + 10.0f;
+        z[i] = bench_random() * 500.0f;
+        radius[i] = bench_random() + 1.5f;
+    }
+
+    std::vector<unsigned char> memory(camera_interest_memory_size(players, entities, 4096) + CAMERA_POOL_ALIGNMENT);
+    void* aligned = (void*)(((uintptr_t)memory.data() + CAMERA_POOL_ALIGNMENT - 1) & ~(uintptr_t)(CAMERA_POOL_ALIGNMENT - 1));
+    CameraInterest interest = camera_interest_init(aligned, players, entities, 4096, 32.0f);
+
+    float matrix[16];
+    for (uint32_t k = 0; k < players; ++k)
+    {
+        camera_view_matrix(&cams[k], matrix);
+    }
+    camera_interest_update(&interest, cams.data(), players, &projection);
+    camera_interest_entities(&interest, x.data(), y.data(), z.data(), radius.data(), entities);
+
+    std::vector<uint32_t> visible(entities);
+    bench_run(_case, players, [&]() {
+        if (_moving)
+        {
+            for (uint32_t k = 0; k < players; ++k)
+            {
+                cams[k].generation++; // Same frustum, but re-inserted
+            }
+            bench_sink = (float)camera_interest_update(&interest, cams.data(), players, &projection);
+        }
+        else
+        {
+            uint32_t total = 0;
+            for (uint32_t k = 0; k < players; ++k)
+            {
+                total += camera_interest_visible_entities(&interest, k, visible.data());
+            }
+            bench_sink = (float)total;
+        }
+    });
+}
+
+template <typename Query>
+static void bench_query(const char* _case, Query _query)
+{
+    std::vector<Camera> cams(bench_cameras, bench_camera(CAMERA_MODE_FREE));
+    const std::vector<BenchInput> inputs = bench_inputs(bench_cameras);
+    float matrix[16];
+    for (uint32_t i = 0; i < bench_cameras; ++i)
+    {
+        camera_rotate(&cams[i], inputs[i].rotation);
+        camera_view_matrix(&cams[i], matrix);
+    }
+
+    bench_run(_case, bench_cameras, [&]() {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < bench_cameras; ++i)
+        {
+            const CameraVec3 v = _query(&cams[i]);
+            sum += v.x + v.y + v.z;
+        }
+        bench_sink = sum;
+    });
+}
+
+int main(int _argc, char** _argv)
+{
+    for (int i = 1; i < _argc; ++i)
+    {
+        if (std::strcmp(_argv[i], "--min-time-ms") == 0 && i + 1 < _argc)
+        {
+            bench_min_time_ms = std::atof(_argv[++i]);
+        }
+        else if (std::strcmp(_argv[i], "--cameras") == 0 && i + 1 < _argc)
+        {
+            const int cameras = std::atoi(_argv[++i]);
+            bench_cameras = cameras > 0 ? (uint32_t)cameras : 1;
+        }
+        else
+        {
+            bench_filter = _argv[i];
+        }
+    }
+
+    const uint32_t clamp_all = CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE;
+
+    // Runtime mode
+    const auto view_matrix = [](Camera* _cam, float* _out) { camera_view_matrix(_cam, _out); };
+    bench_view_matrix("view_matrix/free", CAMERA_MODE_FREE, view_matrix);
+    bench_view_matrix("view_matrix/free_clamped", CAMERA_MODE_FREE | clamp_all, view_matrix);
+    bench_view_matrix("view_matrix/first_person", CAMERA_MODE_FIRST_PERSON, view_matrix);
+    bench_view_matrix("view_matrix/first_person_unclamped", CAMERA_MODE_FIRST_PERSON & ~clamp_all, view_matrix);
+    bench_view_matrix("view_matrix/orbital", CAMERA_MODE_ORBITAL, view_matrix);
+    bench_view_matrix("view_matrix/orbital_unclamped", CAMERA_MODE_ORBITAL & ~clamp_all, view_matrix);
+    bench_view_matrix_idle("view_matrix/idle", CAMERA_MODE_FIRST_PERSON);
+    bench_view_matrix_dirty("view_matrix/dirty", CAMERA_MODE_FIRST_PERSON);
+    bench_view_matrix_interpolated("view_matrix/interpolated", CAMERA_MODE_FIRST_PERSON);
+
+    const auto batch = [](CameraPool* _pool, float* _out) { camera_view_matrix_batch(_pool, _out); };
+    bench_view_matrix_batch("view_matrix_batch/free", CAMERA_MODE_FREE, batch);
+    bench_view_matrix_batch("view_matrix_batch/first_person", CAMERA_MODE_FIRST_PERSON, batch);
+
+    // Column-major 3x4 streamed into 64 byte uniform blocks
+    std::vector<unsigned char> uniforms(64 * (size_t)bench_cameras + CAMERA_POOL_ALIGNMENT);
+    void* uniforms_aligned = (void*)(((uintptr_t)uniforms.data() + CAMERA_POOL_ALIGNMENT - 1) & ~(uintptr_t)(CAMERA_POOL_ALIGNMENT - 1));
+    const CameraOutput output = camera_output(uniforms_aligned, 64, CAMERA_OUTPUT_COLUMN_MAJOR | CAMERA_OUTPUT_3X4 | CAMERA_OUTPUT_STREAM);
+    bench_view_matrix_batch("view_matrix_batch_output/first_person", CAMERA_MODE_FIRST_PERSON,
+        [&](CameraPool* _pool, float*) { camera_view_matrix_batch_output(_pool, &output); });
+
+    // Compile-time mode
+    bench_view_matrix("view_matrix_specialized/free", CAMERA_MODE_FREE,
+        [](Camera* _cam, float* _out) { camera_view_matrix<CAMERA_MODE_FREE>(_cam, _out); });
+    bench_view_matrix("view_matrix_specialized/first_person", CAMERA_MODE_FIRST_PERSON,
+        [](Camera* _cam, float* _out) { camera_view_matrix<CAMERA_MODE_FIRST_PERSON>(_cam, _out); });
+    bench_view_matrix("view_matrix_specialized/orbital", CAMERA_MODE_ORBITAL,
+        [](Camera* _cam, float* _out) { camera_view_matrix<CAMERA_MODE_ORBITAL>(_cam, _out); });
+    bench_view_matrix_batch("view_matrix_batch_specialized/first_person", CAMERA_MODE_FIRST_PERSON,
+        [](CameraPool* _pool, float* _out) { camera_view_matrix_batch<CAMERA_MODE_FIRST_PERSON>(_pool, _out); });
+    bench_registry_grouped("registry/grouped_specialized");
+    bench_boom_batch("boom/apply_request_batch");
+
+    bench_look_at("look_at");
+    bench_look_at_batch("look_at_batch");
+    bench_lod_select("lod_select");
+
+    bench_interest("interest/update", true);
+    bench_interest("interest/visible_entities", false);
+
+    bench_query("query/forward", [](const Camera* _cam) { return camera_forward(_cam); });
+    bench_query("query/up", [](const Camera* _cam) { return camera_up(_cam); });
+    bench_query("query/right", [](const Camera* _cam) { return camera_right(_cam); });
+    bench_query("query/eye", [](const Camera* _cam) { return camera_eye(_cam); });
+
+    return 0;
+}
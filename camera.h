@@ -9,6 +9,7 @@
  * 
  *  - Quaternion based
  *     This naturaly avoids gimbal lock and enables smooth interpolation (ex. for cinematic camera movement)
+ *     'camera_path.h' builds cinematic spline paths (squad orientation, constant speed) from keyframes
  *  - Precise manipulation
  *     A call of 'camera_rotate(&camera, {45 * DEG_TO_RAD, 0, 0});' will rotate exactly 45 degrees.
  *  - Engine agnostic
@@ -23,6 +24,11 @@
  *     You can access and manipulate the entire camera state at any time!
  *  - Supports angle clamping
  *     Restrict the angles your camera is allowed to work in
+ *  - Interest management
+ *     'camera_interest.h' finds the cameras that see a point and the entities a camera sees (ex. for server replication)
+ *  - Look-at helpers
+ *     'camera_look_at_position(..)' aims at a world point, 'camera_look_at_batch(..)' converts arrays of
+ *     direction pairs (ex. for probe baking) with a branch-free conversion
  * 
  * 
  * USAGE:
@@ -42,6 +48,12 @@
  *  This also allowes you to pass and receive arguments without the need to convert them.
  *  See 'camera_math_bx.h' as an example.
  * 
+ *  For SIMD capable targets 'camera_math_sse.h' (SSE2) and 'camera_math_neon.h' (ARM NEON) are provided.
+ *  They are drop-in replacements for 'camera_math_default.h' storing vectors and quaternions in SIMD registers.
+ * 
+ *  Define CAMERA_MATH_FAST before including 'camera.h' to replace libm calls in these backends
+ *   with polynomial approximations from 'camera_math_fast.h' (see there for the error bounds).
+ * 
  * 
  * ANGLE CLAMPING:
  * 
@@ -49,6 +61,7 @@
  *  All limits are expected in radians and min* must be smaller than max*.
  *  They are expected in the range [-pi; pi], with 0 representing no rotation.
  *  The camera rotations are restricting in WORLD space.
+ *  Angles are measured as yaw around the world up axis, followed by pitch and then roll.
  *  This means if pitch AND yaw are clamped, this essentially creates a "window" the camera is not allowed to rotate out of.
  *  
  *  Example for clamping pitch:
@@ -57,6 +70,116 @@
  *                  'camera.minPitch = pi / 2.0f;   // aka restrict to 90 deg downwards'
  * 
  * 
+ * CAMERA POOL:
+ * 
+ *  Many cameras can be stored in a CameraPool, a structure-of-arrays layout of the camera struct.
+ *  camera_view_matrix_batch(..) updates the cameras of a pool in groups of CAMERA_POOL_LANES. The early-out test and the update
+ *   of cameras without smoothing and floating origin run as one loop per step over the group, which the compiler vectorizes.
+ *   The other cameras, and a last partial group, are updated one by one by the same code as camera_view_matrix(..).
+ *  The sines and cosines of the rotations and the view matrices are still computed per camera,
+ *   so a busy batch is about as fast as camera_view_matrix(..) on an array of camera structs.
+ *  The pool does not allocate. Query camera_pool_memory_size(..) and pass aligned memory to camera_pool_init(..).
+ *  
+ *  Example:
+ *   1. 'CameraPool pool = camera_pool_init(memory, 1024);'
+ *   2. 'camera_pool_add(&pool, &camera);'
+ *   3. 'camera_view_matrix_batch(&pool, matrices);  // matrices is a float[16 * pool.count]'
+ *  
+ *  To spread the update across cores, call camera_pool_update(..) on disjoint ranges from your workers,
+ *   or let camera_view_matrix_parallel(..) hand out chunks through a dispatch callback into your job system.
+ *  Ranges on multiples of CAMERA_POOL_LANES never share a cache line, so workers do not false-share.
+ *  
+ *  In C++, camera_view_matrix<mode>(..), camera_pool_update<mode>(..) and camera_view_matrix_batch<mode>(..)
+ *   are specialized for a compile-time mode and have no mode branches. Group the cameras of a pool by mode to use them.
+ *  
+ *  A CameraRegistry wraps a pool and hands out generational CameraHandles that stay valid while cameras move within it.
+ *   Destroyed slots are recycled through a free list, the pool stays dense. camera_registry_compact(..) regroups
+ *   the pool by mode in O(count) and records the [begin; end) range of every mode for camera_pool_update<mode>(..).
+ * 
+ * 
+ * FLOATING ORIGIN:
+ * 
+ *  With CAMERA_MODE_FLOATING_ORIGIN, target_position (and all derived positions) are kept relative to the origin cell camera.origin.
+ *   Once target_position leaves the origin cell, the update moves the origin by whole cells of CAMERA_ORIGIN_CELL_SIZE,
+ *   so the view matrices stay precise tens of kilometres away from the world origin.
+ *  camera_origin(..) returns the origin in double precision. Whenever camera.origin_generation changed,
+ *   re-submit object positions with camera_relative_position(..) instead of transforming them every frame.
+ *  camera_world_position(..) and camera_set_world_position(..) read and write target_position in double precision.
+ * 
+ * 
+ * MATRIX OUTPUT:
+ * 
+ *  camera_view_matrix_output(..), camera_view_matrix_batch_output(..) and camera_pool_update_output(..) write the view matrices
+ *   straight to their destination (ex. a persistently mapped uniform buffer) as described by a CameraOutput:
+ *   with a stride between cameras, row- or column-major, optionally as 3x4 and optionally with non-temporal stores.
+ * 
+ * 
+ * PROJECTION:
+ * 
+ *  A CameraProjection describes a perspective or orthographic projection (optionally reversed-Z, infinite far or [-1; 1] depth).
+ *  camera_matrices(..) updates the camera and generates the view, projection, view-projection
+ *   and their inverses in one pass. The inverses are built analytically, not by general 4x4 inversion.
+ *  camera_temporal_matrices(..) additionally keeps the matrices of the previous frame in a CameraTemporal, applies
+ *   Halton sub-pixel jitter and generates the reprojection from this frame to the previous one (ex. for TAA and motion blur).
+ *  camera_frustum(..) extracts the frustum planes from the view-projection,
+ *   camera_cull_spheres(..) and camera_cull_aabbs(..) test arrays of bounding volumes against them.
+ *  camera_lod_select(..) measures arrays of bounding spheres from camera.eye (squared distance, projected pixel radius)
+ *   and picks their level of detail, with hysteresis so objects near a threshold do not pop between levels.
+ *  camera_stereo_views(..), camera_cube_views(..) and camera_cascade_views(..) derive further views (VR eyes,
+ *   cube map faces, shadow cascades) from the last update by offsetting or replacing its basis, without updating again.
+ * 
+ * 
+ * REPLICATION:
+ * 
+ *  camera_pack(..) stores the replicated subset of a camera (target_position, target_distance, orientation)
+ *   in a 16 byte CameraPacked, quantized as described by a CameraPacking. camera_unpack(..) restores it.
+ *  camera_pool_pack(..) and camera_pool_unpack(..) do the same for many cameras of a pool at once.
+ * 
+ * 
+ * FIXED TIMESTEP:
+ * 
+ *  Every camera_view_matrix(..) keeps the view state it replaced in previous_position, previous_distance and previous_orientation.
+ *  Update the camera once per simulation step and call camera_view_matrix_interpolated(..) once per rendered frame:
+ *   it blends the last two steps (lerp of position and distance, nlerp of the orientation) without updating the camera.
+ *  After teleporting a camera, also set its previous_* members to avoid blending across the jump.
+ * 
+ * 
+ * SMOOTHING:
+ * 
+ *  Point camera.smoothing to a CameraSmoothing (see camera_smoothing(..)) to follow target_position, target_distance
+ *   and orientation with critically damped springs instead of snapping to them (ex. for third person and orbital cameras).
+ *  The coefficients only depend on the smoothing times and the time step, so they are computed once and shared by many cameras.
+ *  The view matrix and the query functions then describe the smoothed view_position, view_distance and view_orientation.
+ *  Movement still follows the unsmoothed orientation. Set view_* to the camera state to skip the smoothing after a teleport.
+ * 
+ * 
+ * BOOM:
+ * 
+ *  Keeps the eye of third person and orbital cameras out of geometry between it and the view position.
+ *  camera_boom_ray(..) returns the ray to cast into your physics world, camera_boom_apply(..) takes its hit distance
+ *   and pulls camera.boom_distance in (or lets it out again) as described by a CameraBoom (see camera_boom(..)).
+ *  The query does not have to complete within the frame: request after this frame's update, apply before the next one.
+ *  camera_boom_request_batch(..) hands the rays of a whole pool to one CameraBoomQueryFn call (ex. an async raycast batch)
+ *   and camera_boom_apply_batch(..) applies its results.
+ *  Once let out to the view distance the boom turns off (CAMERA_BOOM_OFF) and an idle camera takes the early-out again.
+ * 
+ * 
+ * EVENT-DRIVEN RENDERING:
+ * 
+ *  camera.dirty tells whether the view matrix would change, so viewports only have to be redrawn while it is set.
+ *  It is set by camera_move(..), camera_rotate(..), camera_look_at(..), the camera_set_*(..) setters, camera_unpack(..)
+ *   and camera_boom_apply(..) (and their pool versions). Call camera_mark_dirty(..) after manipulating other members directly.
+ *  camera_view_matrix(..) clears it, unless the view is still being smoothed towards the camera state.
+ *  When a clean camera is marked dirty, camera.on_change(camera.on_change_user) is called (ex. to wake up the render loop).
+ *   It is called once per change from rest, not for every input.
+ * 
+ * 
+ * TRACK RECORDING:
+ * 
+ *  'camera_track.h' records input and resulting state per frame into a delta coded file
+ *   and plays it back from a memory mapping with keyframe seeking (see there).
+ * 
+ * 
  * GENERAL NOTES:
  * 
  *  ALL camera struct members can be safely manipulated at any time.
@@ -67,7 +190,20 @@
  *   many rotations in differing axies well and thus require occasional re-normalization.
  *   To accomodate for this and for general performance reasons changes are accumulated and the
  *   orientation quaternion is only updated when the view matrix is requested (once per frame).
+ *   The orientation is only re-normalized once its norm drifted more than CAMERA_NORMALIZE_EPSILON.
  * 
+ *  Define CAMERA_CONCURRENT_INPUT to call camera_move(..), camera_rotate(..), camera_pool_move(..) and camera_pool_rotate(..)
+ *   from any thread while another thread updates the camera. Input is accumulated with lock-free atomics
+ *   and drained by the update, so none is lost. A call racing the update may be split across two frames.
+ *   Marking the camera dirty is atomic as well, camera.on_change is called on the thread that marked it.
+ *   All other members must still only be manipulated by the updating thread.
+ * 
+ *  Define CAMERA_PROFILE to instrument the view matrix update. The clamp, orientation, position and matrix phases
+ *   are wrapped in CAMERA_PROFILE_BEGIN(..) / CAMERA_PROFILE_END(..), which you can forward to your profiler,
+ *   and camera_profile_counters(..) counts updates, early-outs, phases and transcendental calls per thread.
+ *   Without CAMERA_PROFILE all instrumentation compiles to nothing.
+ * 
+ *  The query functions return cached values, which are only updated when pending changes are applied.
  *  Query functions only return the correct value AFTER pending changes have been applied. (i.e. calling camera_view_matrix(..))
  *   Example:
  *   1. camera_move(..)          // Changes NOT yet applied
@@ -105,6 +241,9 @@
 #ifndef CAMERA_HEADER_GUARD
 #define CAMERA_HEADER_GUARD
 
+#include <float.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "camera_math.h"
 
@@ -114,6 +253,26 @@
 #define CAMERA_WORLD_UP                     CameraVec3(0.0f, 1.0f, 0.0f)
 #define CAMERA_WORLD_RIGHT                  CameraVec3(1.0f, 0.0f, 0.0f)
 
+// Edge length of an origin cell of CAMERA_MODE_FLOATING_ORIGIN in world units
+//  The origin moves by whole cells once target_position leaves [-size; size] on an axis, so positions relative to it
+//  stay below 1.5 cells. Powers of two keep the rebasing exact. Define it before including 'camera.h' to change it.
+#ifndef CAMERA_ORIGIN_CELL_SIZE
+#define CAMERA_ORIGIN_CELL_SIZE             1024.0f
+#endif
+
+// Smoothing springs closer to rest than this (offset and velocity per component) snap onto the camera state
+//  Once all springs rest, an idle camera takes the early-out again. Define it before including 'camera.h' to change it.
+#ifndef CAMERA_SMOOTHING_EPSILON
+#define CAMERA_SMOOTHING_EPSILON            1e-5f
+#endif
+
+// Largest tolerated deviation of the squared orientation norm from 1 before it is re-normalized
+//  Small per-frame rotations drift very slowly, so most updates skip the re-normalization.
+//  Basis vectors stay unit length within about twice this value. Define it before including 'camera.h' to change it.
+#ifndef CAMERA_NORMALIZE_EPSILON
+#define CAMERA_NORMALIZE_EPSILON            1e-6f
+#endif
+
 // Camera mode configuration flags
 //  Can be combined with bitwise OR
 #define CAMERA_MODE_DISABLE_ROLL            UINT32_C(0x00000001) // Disables the roll axis
@@ -121,6 +280,7 @@
 #define CAMERA_MODE_CLAMP_PITCH_ANGLE       UINT32_C(0x00000004) // Limits the pitch angle. Typically used in first/third person to prevent overrotation  (i.e. somersaults).
 #define CAMERA_MODE_CLAMP_YAW_ANGLE         UINT32_C(0x00000008) // Limits the yaw angle.
 #define CAMERA_MODE_CLAMP_ROLL_ANGLE        UINT32_C(0x00000010) // Limits the roll angle.
+#define CAMERA_MODE_FLOATING_ORIGIN         UINT32_C(0x00000020) // Keeps target_position relative to an origin cell. See "Floating Origin".
 
 // Free float camera mode (no restrictions applied)
 #define CAMERA_MODE_FREE (0)
@@ -149,6 +309,17 @@
 
 /* Camera struct */
 
+// Coefficients of critically damped springs for one time step, see camera_smoothing(..)
+//  Per spring: the weights of offset and velocity in the new offset, followed by their weights in the new velocity.
+typedef struct camera_smoothing {
+    float position[4];
+    float distance[4];
+    float orientation[4];
+} CameraSmoothing;
+
+// Called when a camera at rest is marked dirty, see "Event-Driven Rendering"
+typedef void (*CameraChangeFn)(void* _user);
+
 typedef struct camera {
     CameraVec3 target_position;         // The target point, the camera is looking at. Aka camera eye position if camera.target_distance == 0.
     float target_distance;              // Camera distance from eye to target. Note: negative values create zoom-like behaviour.
@@ -158,6 +329,12 @@ typedef struct camera {
     // Temporary accumulator. Cleared on camera_view_matrix(..).
     CameraVec3 movement_accumulator;
     CameraVec3 rotation_accumulator;
+
+    // Set by the input functions and setters, cleared by camera_view_matrix(..) once the view is at rest. See "Event-Driven Rendering".
+    uint32_t dirty;
+    // Called with on_change_user when the camera is marked dirty while it was clean. NULL (the default) calls nothing.
+    CameraChangeFn on_change;
+    void* on_change_user;
     // Angle clamping limits. See "Angle Clamping" for further information.
     float minPitch;
     float maxPitch;
@@ -165,9 +342,460 @@ typedef struct camera {
     float maxYaw;
     float minRoll;
     float maxRoll;
+
+    // Smooths the view towards the camera state. NULL (the default) snaps the view to it. See "Smoothing".
+    //  Shared by all cameras with the same smoothing times and time step.
+    const CameraSmoothing* smoothing;
+
+    // Largest distance of the eye from the view position, set by camera_boom_apply(..) to keep the eye out of geometry.
+    //  CAMERA_BOOM_OFF (the default) leaves the eye at the view distance. See "Boom".
+    float boom_distance;
+
+    // Derived state. Updated on camera_view_matrix(..) and returned by the query functions.
+    CameraVec3 forward;
+    CameraVec3 up;
+    CameraVec3 right;
+    CameraVec3 eye;
+
+    // Current (pitch, yaw, roll) of the orientation in world space. Only maintained while angle clamping is active.
+    //  Tracked from the applied rotations and only re-extracted from the orientation when it can not be tracked.
+    CameraVec3 angles;
+
+    // State applied by the last camera_view_matrix(..). Used to detect direct manipulation of the camera struct.
+    CameraVec3 applied_position;
+    float applied_distance;
+    CameraQuat applied_orientation;
+    uint32_t applied_mode;
+    float applied_limits[6];            // minPitch, maxPitch, minYaw, maxYaw, minRoll, maxRoll
+    float applied_boom_distance;
+
+    // State the last view matrix was generated from. Trails the camera state while smoothing, otherwise equal to it.
+    CameraVec3 view_position;
+    float view_distance;
+    CameraQuat view_orientation;
+
+    // Rate of change per second of the view state. Only non-zero while smoothing.
+    CameraVec3 position_velocity;
+    float distance_velocity;
+    CameraQuat orientation_velocity;
+
+    // View state of the camera_view_matrix(..) call before the last one. Blended with view_* by camera_view_matrix_interpolated(..).
+    CameraVec3 previous_position;
+    float previous_distance;
+    CameraQuat previous_orientation;
+
+    // Incremented whenever camera_view_matrix(..) updates the view. 0 means the view was never generated.
+    //  Compare it against a previously seen value to skip work that only depends on the view (ex. uniform uploads, culling).
+    uint32_t generation;
+
+    // Origin cell of CAMERA_MODE_FLOATING_ORIGIN. All positions of the camera are relative to origin * CAMERA_ORIGIN_CELL_SIZE.
+    int32_t origin[3];
+    uint32_t origin_generation;         // Incremented whenever the origin moves. Re-submit positions relative to the origin then.
 } Camera;
 
 
+/* Camera pool */
+
+// Alignment (in bytes) of every array in a camera pool
+//  Pool capacities are rounded up to multiples of CAMERA_POOL_LANES,
+//  so every group of CAMERA_POOL_LANES cameras starts on its own cache line in every array.
+#define CAMERA_POOL_ALIGNMENT               64
+#define CAMERA_POOL_LANES                   (CAMERA_POOL_ALIGNMENT / 4)
+
+// Structure-of-arrays layout of the camera struct.
+//  Each entry maps one pool array to the camera member it mirrors: _apply(type, array, member)
+//  The members written by the input functions are kept separate, as the batch update drains them instead of copying them.
+#define CAMERA_POOL_FIELDS(_apply) \
+    CAMERA_POOL_STATE_FIELDS(_apply) \
+    CAMERA_POOL_INPUT_FIELDS(_apply)
+
+#define CAMERA_POOL_INPUT_FIELDS(_apply) \
+    _apply(float,    movement_accumulator_x, movement_accumulator.x) \
+    _apply(float,    movement_accumulator_y, movement_accumulator.y) \
+    _apply(float,    movement_accumulator_z, movement_accumulator.z) \
+    _apply(float,    rotation_accumulator_x, rotation_accumulator.x) \
+    _apply(float,    rotation_accumulator_y, rotation_accumulator.y) \
+    _apply(float,    rotation_accumulator_z, rotation_accumulator.z) \
+    _apply(uint32_t, dirty,                  dirty) \
+    _apply(CameraChangeFn, on_change,        on_change) \
+    _apply(void*,    on_change_user,         on_change_user)
+
+// The state is further split by how the batch update uses it, so it only copies what the mode of a camera needs.
+#define CAMERA_POOL_STATE_FIELDS(_apply) \
+    CAMERA_POOL_SETTINGS_FIELDS(_apply) \
+    CAMERA_POOL_UPDATED_FIELDS(_apply) \
+    CAMERA_POOL_VELOCITY_FIELDS(_apply) \
+    CAMERA_POOL_ANGLE_FIELDS(_apply) \
+    CAMERA_POOL_ORIGIN_FIELDS(_apply) \
+    CAMERA_POOL_BASIS_FIELDS(_apply) \
+    CAMERA_POOL_PREVIOUS_FIELDS(_apply)
+
+// Read, but never written by the update
+#define CAMERA_POOL_SETTINGS_FIELDS(_apply) \
+    _apply(float,    target_distance,        target_distance) \
+    _apply(uint32_t, mode,                   mode) \
+    _apply(float,    minPitch,               minPitch) \
+    _apply(float,    maxPitch,               maxPitch) \
+    _apply(float,    minYaw,                 minYaw) \
+    _apply(float,    maxYaw,                 maxYaw) \
+    _apply(float,    minRoll,                minRoll) \
+    _apply(float,    maxRoll,                maxRoll) \
+    _apply(const CameraSmoothing*, smoothing, smoothing) \
+    _apply(float,    boom_distance,          boom_distance)
+
+// Read and written by every update that does not take the early-out
+#define CAMERA_POOL_UPDATED_FIELDS(_apply) \
+    _apply(float,    target_position_x,      target_position.x) \
+    _apply(float,    target_position_y,      target_position.y) \
+    _apply(float,    target_position_z,      target_position.z) \
+    _apply(float,    orientation_x,          orientation.x) \
+    _apply(float,    orientation_y,          orientation.y) \
+    _apply(float,    orientation_z,          orientation.z) \
+    _apply(float,    orientation_w,          orientation.w) \
+    _apply(float,    applied_position_x,     applied_position.x) \
+    _apply(float,    applied_position_y,     applied_position.y) \
+    _apply(float,    applied_position_z,     applied_position.z) \
+    _apply(float,    applied_distance,       applied_distance) \
+    _apply(float,    applied_orientation_x,  applied_orientation.x) \
+    _apply(float,    applied_orientation_y,  applied_orientation.y) \
+    _apply(float,    applied_orientation_z,  applied_orientation.z) \
+    _apply(float,    applied_orientation_w,  applied_orientation.w) \
+    _apply(uint32_t, applied_mode,           applied_mode) \
+    _apply(float,    applied_minPitch,       applied_limits[0]) \
+    _apply(float,    applied_maxPitch,       applied_limits[1]) \
+    _apply(float,    applied_minYaw,         applied_limits[2]) \
+    _apply(float,    applied_maxYaw,         applied_limits[3]) \
+    _apply(float,    applied_minRoll,        applied_limits[4]) \
+    _apply(float,    applied_maxRoll,        applied_limits[5]) \
+    _apply(float,    applied_boom_distance,  applied_boom_distance) \
+    _apply(float,    view_position_x,        view_position.x) \
+    _apply(float,    view_position_y,        view_position.y) \
+    _apply(float,    view_position_z,        view_position.z) \
+    _apply(float,    view_distance,          view_distance) \
+    _apply(float,    view_orientation_x,     view_orientation.x) \
+    _apply(float,    view_orientation_y,     view_orientation.y) \
+    _apply(float,    view_orientation_z,     view_orientation.z) \
+    _apply(float,    view_orientation_w,     view_orientation.w) \
+    _apply(uint32_t, generation,             generation)
+
+// Only read with smoothing, written by every update that does not take the early-out
+#define CAMERA_POOL_VELOCITY_FIELDS(_apply) \
+    _apply(float,    position_velocity_x,    position_velocity.x) \
+    _apply(float,    position_velocity_y,    position_velocity.y) \
+    _apply(float,    position_velocity_z,    position_velocity.z) \
+    _apply(float,    distance_velocity,      distance_velocity) \
+    _apply(float,    orientation_velocity_x, orientation_velocity.x) \
+    _apply(float,    orientation_velocity_y, orientation_velocity.y) \
+    _apply(float,    orientation_velocity_z, orientation_velocity.z) \
+    _apply(float,    orientation_velocity_w, orientation_velocity.w)
+
+// Only read and written with angle clamping
+#define CAMERA_POOL_ANGLE_FIELDS(_apply) \
+    _apply(float,    angles_x,               angles.x) \
+    _apply(float,    angles_y,               angles.y) \
+    _apply(float,    angles_z,               angles.z)
+
+// Only read and written with CAMERA_MODE_FLOATING_ORIGIN
+#define CAMERA_POOL_ORIGIN_FIELDS(_apply) \
+    _apply(int32_t,  origin_x,               origin[0]) \
+    _apply(int32_t,  origin_y,               origin[1]) \
+    _apply(int32_t,  origin_z,               origin[2]) \
+    _apply(uint32_t, origin_generation,      origin_generation)
+
+// Only read by the early-out, written by every other update
+#define CAMERA_POOL_BASIS_FIELDS(_apply) \
+    _apply(float,    forward_x,              forward.x) \
+    _apply(float,    forward_y,              forward.y) \
+    _apply(float,    forward_z,              forward.z) \
+    _apply(float,    up_x,                   up.x) \
+    _apply(float,    up_y,                   up.y) \
+    _apply(float,    up_z,                   up.z) \
+    _apply(float,    right_x,                right.x) \
+    _apply(float,    right_y,                right.y) \
+    _apply(float,    right_z,                right.z) \
+    _apply(float,    eye_x,                  eye.x) \
+    _apply(float,    eye_y,                  eye.y) \
+    _apply(float,    eye_z,                  eye.z)
+
+// Written by every update, never read by it
+#define CAMERA_POOL_PREVIOUS_FIELDS(_apply) \
+    _apply(float,    previous_position_x,    previous_position.x) \
+    _apply(float,    previous_position_y,    previous_position.y) \
+    _apply(float,    previous_position_z,    previous_position.z) \
+    _apply(float,    previous_distance,      previous_distance) \
+    _apply(float,    previous_orientation_x, previous_orientation.x) \
+    _apply(float,    previous_orientation_y, previous_orientation.y) \
+    _apply(float,    previous_orientation_z, previous_orientation.z) \
+    _apply(float,    previous_orientation_w, previous_orientation.w)
+
+// Many cameras stored as structure-of-arrays.
+//  Camera i is made up of pool.<array>[i] for every array in CAMERA_POOL_FIELDS.
+//  Like the camera struct, all arrays can be safely manipulated at any time.
+typedef struct camera_pool {
+    uint32_t count;                     // Number of cameras in use. Cameras [0; count) are updated by camera_view_matrix_batch(..).
+    uint32_t capacity;                  // Number of cameras the arrays can hold. Always a multiple of CAMERA_POOL_LANES.
+
+#define CAMERA_POOL_DECLARE_ARRAY(_type, _array, _member) _type* _array;
+    CAMERA_POOL_FIELDS(CAMERA_POOL_DECLARE_ARRAY)
+#undef CAMERA_POOL_DECLARE_ARRAY
+} CameraPool;
+
+// Parallel update of a camera pool
+//  Workers claim chunks of chunk_size cameras until the pool is exhausted, so faster workers take over more chunks.
+//  Set up with camera_pool_job(..), then call camera_pool_job_run(..) from every worker.
+typedef struct camera_pool_job {
+    CameraPool* pool;
+    float* out_matrices;
+    uint32_t chunk_size;                // Cameras per claim. Always a multiple of CAMERA_POOL_LANES.
+    uint32_t end;                       // Cameras [0; end) are updated
+    uint32_t next;                      // First unclaimed camera. Advanced atomically by the workers.
+} CameraPoolJob;
+
+// Dispatch hook for camera_view_matrix_parallel(..)
+//  Must call _run(_job) once on each of _worker_count workers and return once all of them have finished.
+//  _user is passed through from camera_view_matrix_parallel(..), ex. to access your job system.
+typedef void (*CameraPoolDispatchFn)(void* _user, uint32_t _worker_count, void (*_run)(void* _job), void* _job);
+
+
+/* Camera registry */
+
+// Largest number of mode groups reported by camera_registry_compact(..)
+#define CAMERA_REGISTRY_MAX_GROUPS          16
+
+// Mode of the last group once there are more distinct modes than CAMERA_REGISTRY_MAX_GROUPS
+#define CAMERA_REGISTRY_MIXED_MODE          UINT32_MAX
+
+// Stable reference to a camera of a registry
+//  Stays valid while the camera moves within the pool and is invalidated when it is destroyed.
+//  Generations of live cameras are odd, so a zero-initialized handle never refers to a camera.
+typedef struct camera_handle {
+    uint32_t slot;
+    uint32_t generation;
+} CameraHandle;
+
+// Cameras [begin; end) of a registry pool sharing the same mode
+typedef struct camera_registry_group {
+    uint32_t mode;
+    uint32_t begin;
+    uint32_t end;
+} CameraRegistryGroup;
+
+// Camera pool that hands out stable handles
+//  The pool stays dense: destroying a camera moves the last camera into its place.
+//  camera_registry_compact(..) regroups the pool by mode, so every group can be updated with its mode specialization.
+typedef struct camera_registry {
+    CameraPool pool;                    // Cameras [0; pool.count) are alive. Update them like any other pool.
+    uint32_t* slot_generation;          // [capacity] generation of every handle slot, odd while the slot is in use
+    uint32_t* slot_index;               // [capacity] pool index of a slot in use, next free slot of a free one
+    uint32_t* pool_slot;                // [capacity] handle slot of every pool index
+    uint32_t* scratch;                  // [capacity] used by camera_registry_compact(..)
+    uint32_t free_slot;                 // First free slot, UINT32_MAX if all slots are in use
+    uint32_t group_count;               // Groups of the last camera_registry_compact(..), 0 once cameras were created or destroyed since
+    CameraRegistryGroup groups[CAMERA_REGISTRY_MAX_GROUPS];
+} CameraRegistry;
+
+
+/* Boom */
+
+// camera.boom_distance of a camera without occlusion
+#define CAMERA_BOOM_OFF                     FLT_MAX
+
+// Ray of a boom query, from the view position (the pivot) towards the eye
+typedef struct camera_boom_ray {
+    CameraVec3 origin;
+    CameraVec3 direction;               // Normalized, -camera.forward
+    float length;                       // View distance plus the boom radius
+} CameraBoomRay;
+
+// Occlusion handling of the eye for one time step, see camera_boom(..)
+//  Shared by all cameras with the same configuration and time step.
+typedef struct camera_boom {
+    float radius;                       // Distance kept between the eye and the hit geometry
+    float min_distance;                 // The eye is never pulled closer to the view position
+    float in_blend;                     // Fraction of the remaining distance moved per step when pulled in
+    float out_blend;                    // Fraction of the remaining distance moved per step when let out
+} CameraBoom;
+
+// Ray query into your physics world
+//  Write the distance to the first hit along every ray to _out_distances, or the ray length if nothing was hit.
+//  The results may be written after returning (ex. by an asynchronous query), see camera_boom_request_batch(..).
+typedef void (*CameraBoomQueryFn)(void* _user, const CameraBoomRay* _rays, uint32_t _count, float* _out_distances);
+
+
+/* Matrix output */
+
+// Matrix output configuration flags
+//  Can be combined with bitwise OR
+#define CAMERA_OUTPUT_COLUMN_MAJOR          UINT32_C(0x00000001) // Writes the transposed matrix (translation in elements 3, 7 and 11)
+#define CAMERA_OUTPUT_3X4                   UINT32_C(0x00000002) // Drops the constant (0, 0, 0, 1) row or column and writes 12 floats
+#define CAMERA_OUTPUT_STREAM                UINT32_C(0x00000004) // Uses non-temporal stores that bypass the cache (ex. for write-combined GPU memory)
+
+// Describes where and how view matrices are written, ex. straight into a mapped uniform buffer
+//  Without flags a matrix is written exactly like the float[16] of camera_view_matrix(..).
+//  CAMERA_OUTPUT_3X4 combined with CAMERA_OUTPUT_COLUMN_MAJOR is the common float3x4 / mat3x4 uniform layout.
+//  CAMERA_OUTPUT_STREAM only takes effect on SSE2 targets for 16 byte aligned rows of 4 floats, otherwise it uses regular stores.
+//   Streaming partial cache lines (ex. a 3x4 per 64 byte block) into cached memory is slower than regular stores.
+typedef struct camera_output {
+    void* data;                         // Destination of the first matrix
+    uint32_t stride;                    // Bytes from one camera to the next (ex. the size of a per-camera uniform block)
+    uint32_t flags;                     // See CAMERA_OUTPUT_* defines
+} CameraOutput;
+
+
+/* Projection */
+
+// Projection types
+#define CAMERA_PROJECTION_PERSPECTIVE       UINT32_C(0x00000000)
+#define CAMERA_PROJECTION_ORTHOGRAPHIC      UINT32_C(0x00000001)
+
+// Projection configuration flags
+//  Can be combined with bitwise OR
+#define CAMERA_PROJECTION_REVERSED_Z        UINT32_C(0x00000002) // Maps the near plane to depth 1 and the far plane to depth 0
+#define CAMERA_PROJECTION_INFINITE_FAR      UINT32_C(0x00000004) // Ignores far_plane and pushes it to infinity. Perspective only.
+#define CAMERA_PROJECTION_HOMOGENEOUS_DEPTH UINT32_C(0x00000008) // Depth range [-1; 1] (ex. OpenGL) instead of [0; 1]
+
+// Describes how the view space of a camera is projected
+//  Projection matrices use the same layout as the view matrix and look down CAMERA_WORLD_FORWARD.
+typedef struct camera_projection {
+    uint32_t flags;                     // Projection type and configuration. See CAMERA_PROJECTION_* defines.
+    float fov_y;                        // Vertical field of view in radians. Perspective only.
+    float height;                       // Vertical size of the view volume. Orthographic only.
+    float aspect;                       // Width divided by height.
+    float near_plane;                   // Distance of the near plane. Must be > 0 for perspective projections.
+    float far_plane;                    // Distance of the far plane. Must be > near_plane.
+} CameraProjection;
+
+// All matrices of a camera, generated in one pass by camera_matrices(..)
+//  view_projection transforms world space to clip space, inverse_view_projection transforms it back.
+typedef struct camera_matrices {
+    float view[16];
+    float projection[16];
+    float view_projection[16];
+    float inverse_view[16];
+    float inverse_projection[16];
+    float inverse_view_projection[16];
+} CameraMatrices;
+
+// Matrices of temporal techniques (ex. TAA, motion blur, temporal upscaling), generated by camera_temporal_matrices(..)
+//  Keep one per camera across frames: each call moves the matrices of the last frame into the previous_* members.
+//  All members except jitter_length are outputs. Motion vectors are measured between the unjittered matrices.
+typedef struct camera_temporal {
+    uint32_t jitter_length;             // Length of the Halton (2, 3) sub-pixel jitter sequence. 0 disables jitter.
+    uint32_t frame;                     // Number of camera_temporal_matrices(..) calls. 0 means there is no previous frame.
+    float jitter[2];                    // Sub-pixel offset of this frame in pixels, within [-0.5; 0.5]
+    CameraProjection projection;
+    CameraProjection previous_projection;
+    float view[16];
+    float previous_view[16];
+    float view_projection[16];          // Unjittered
+    float previous_view_projection[16]; // Unjittered
+    float jittered_projection[16];
+    float jittered_view_projection[16]; // Render with this one
+    float reprojection[16];             // Maps unjittered clip space of this frame to clip space of the previous frame
+    int32_t origin[3];                  // Origin cell the matrices are relative to, see CAMERA_MODE_FLOATING_ORIGIN
+} CameraTemporal;
+
+
+/* Frustum */
+
+// Frustum plane indices
+#define CAMERA_FRUSTUM_LEFT                 0
+#define CAMERA_FRUSTUM_RIGHT                1
+#define CAMERA_FRUSTUM_BOTTOM               2
+#define CAMERA_FRUSTUM_TOP                  3
+#define CAMERA_FRUSTUM_NEAR                 4
+#define CAMERA_FRUSTUM_FAR                  5
+#define CAMERA_FRUSTUM_PLANES               6
+
+// World space view frustum
+//  A point p is inside if dot(plane.xyz, p) + plane.w >= 0 for all planes. Plane normals are normalized and point inwards.
+//  Planes that do not exist (ex. an infinite far plane) are stored as (0, 0, 0, 1) and accept everything.
+typedef struct camera_frustum {
+    float planes[CAMERA_FRUSTUM_PLANES][4];
+} CameraFrustum;
+
+
+/* Level of detail */
+
+// Largest number of levels of a CameraLod
+#define CAMERA_LOD_LEVELS                   8
+
+// Level of detail selection by projected screen space radius, see camera_lod_select(..)
+//  Level i is selected while the radius is >= pixel_radius[i], the last level (count - 1) below pixel_radius[count - 2].
+//  An object only moves to another level once its radius crossed the threshold by the hysteresis fraction of it.
+typedef struct camera_lod {
+    uint32_t count;                     // Number of levels, 1 to CAMERA_LOD_LEVELS
+    float hysteresis;                   // Fraction of the threshold (ex. 0.1 for 10%). 0 disables hysteresis.
+    float pixel_radius[CAMERA_LOD_LEVELS - 1]; // Descending thresholds in pixels between level i and i + 1
+} CameraLod;
+
+
+/* Multi-view */
+
+// Cube map faces of camera_cube_views(..) in the usual face order
+#define CAMERA_CUBE_POSITIVE_X              0
+#define CAMERA_CUBE_NEGATIVE_X              1
+#define CAMERA_CUBE_POSITIVE_Y              2
+#define CAMERA_CUBE_NEGATIVE_Y              3
+#define CAMERA_CUBE_POSITIVE_Z              4
+#define CAMERA_CUBE_NEGATIVE_Z              5
+#define CAMERA_CUBE_FACES                   6
+
+
+/* Profiling */
+
+// Phases of the view matrix update, see CAMERA_PROFILE
+#define CAMERA_PROFILE_PHASE_CLAMP          0 // Angle clamping (only if a CAMERA_MODE_CLAMP_* flag is set)
+#define CAMERA_PROFILE_PHASE_ORIENTATION    1 // Orientation and basis vector update
+#define CAMERA_PROFILE_PHASE_POSITION       2 // target_position and eye update
+#define CAMERA_PROFILE_PHASE_MATRIX         3 // View matrix generation
+#define CAMERA_PROFILE_PHASES               4
+
+// Scope hooks around each phase. Define them before including 'camera.h' to forward the phases to your profiler.
+//  _name is a unique identifier per phase (camera_clamp, camera_orientation, camera_position, camera_matrix),
+//  BEGIN and END of one phase are always in the same scope.
+//   Example (Tracy): '#define CAMERA_PROFILE_BEGIN(_name) TracyCZoneN(_name, #_name, 1)'
+//                    '#define CAMERA_PROFILE_END(_name) TracyCZoneEnd(_name)'
+#ifndef CAMERA_PROFILE_BEGIN
+#define CAMERA_PROFILE_BEGIN(_name)
+#endif
+#ifndef CAMERA_PROFILE_END
+#define CAMERA_PROFILE_END(_name)
+#endif
+
+// Per thread counters of the camera updates, see camera_profile_counters(..)
+typedef struct camera_profile_counters {
+    uint64_t updates;                       // Cameras updated (camera_view_matrix(..) and every camera of a batch)
+    uint64_t early_outs;                    // Updates without pending changes, which re-emitted the previous view
+    uint64_t phases[CAMERA_PROFILE_PHASES]; // Times each CAMERA_PROFILE_PHASE_* was entered, by a batch once per group of lanes
+    uint64_t sincos;                        // cm_sincos(..) calls
+    uint64_t asin;                          // cm_asin(..) calls
+    uint64_t atan2;                         // cm_atan2(..) calls
+    uint64_t renormalizations;              // Orientation re-normalizations, see CAMERA_NORMALIZE_EPSILON
+} CameraProfileCounters;
+
+
+/* Replication */
+
+// Size (in bytes) of a packed camera
+#define CAMERA_PACKED_SIZE                  16
+
+// Quantization of a packed camera
+//  target_position is stored in steps of position_step, covering +-(2^20 - 1) steps on every axis.
+//  target_distance is stored in 2^16 - 1 steps covering [-max_distance; max_distance], negative distances (zoom) included.
+//  The orientation is stored as smallest-three quaternion with 15 bits per component (error below 1.3e-4 radians).
+typedef struct camera_packing {
+    float position_step;
+    float max_distance;
+} CameraPacking;
+
+// The replicated subset of a camera (target_position, target_distance, orientation) in CAMERA_PACKED_SIZE bytes
+//  The byte layout is independent of the platform, it can be sent as is.
+typedef struct camera_packed {
+    uint8_t data[CAMERA_PACKED_SIZE];
+} CameraPacked;
+
+
 /* Function declarations */
 
 // Initialize/Reset the camera struct.
@@ -195,256 +823,3775 @@ extern void camera_move(Camera* _cam, const CameraVec3 _offset);
 // Note: angles are expected in radians
 extern void camera_rotate(Camera* _cam, const CameraVec3 _angles);
 
+// Set camera.dirty and call camera.on_change if the camera was clean
+//  The input functions and setters call this. Call it after manipulating other members directly.
+extern void camera_mark_dirty(Camera* _cam);
+
+// Set camera.target_position and mark the camera dirty
+extern void camera_set_position(Camera* _cam, CameraVec3 _position);
+
+// Set camera.target_distance and mark the camera dirty
+extern void camera_set_distance(Camera* _cam, float _distance);
+
+// Set camera.orientation and mark the camera dirty
+// Note: _orientation is expected to be normalized
+extern void camera_set_orientation(Camera* _cam, CameraQuat _orientation);
+
+// Set camera.mode and mark the camera dirty
+extern void camera_set_mode(Camera* _cam, uint32_t _mode);
+
+// Write the world position of the origin of CAMERA_MODE_FLOATING_ORIGIN
+//  View matrices and all positions of the camera are relative to it. Fetch it again whenever camera.origin_generation changed.
+// Note: _out_origin is expected to be a double[3]
+extern void camera_origin(const Camera* _cam, double* _out_origin);
+
+// Write the world position of camera.target_position
+// Note: _out_position is expected to be a double[3]
+extern void camera_world_position(const Camera* _cam, double* _out_position);
+
+// Move camera.target_position to a world position
+//  With CAMERA_MODE_FLOATING_ORIGIN the origin moves onto the cell of _position (without changing the view, derived state follows on the next update).
+//  Otherwise the origin is left as is and target_position is written relative to it.
+// Note: _position is expected to be a double[3]
+extern void camera_set_world_position(Camera* _cam, const double* _position);
+
+// Write a world position relative to the origin of the camera, ex. an object position to submit for rendering
+// Note: _position is expected to be a double[3], _out_position a float[3]
+extern void camera_relative_position(const Camera* _cam, const double* _position, float* _out_position);
+
 // Rotate the camera to look into the direction _forward
 //  This only changes the camera.orientation, it will still face its camera.target_position!
 // Note: _forward and _up are expected to be normalized
 extern void camera_look_at(Camera* _cam, CameraVec3 _forward, CameraVec3 _up);
 
+// Rotate the camera to look from its eye at _target_point
+//  The eye is derived from the current target_position, target_distance and orientation and stays in place:
+//  target_position moves onto the new view direction at target_distance from the eye.
+// Note: _target_point must differ from the eye and _up must not be parallel to the direction towards it
+extern void camera_look_at_position(Camera* _cam, CameraVec3 _target_point, CameraVec3 _up);
+
+// Convert _count forward and up direction pairs to orientations, the same as camera_look_at(..) for each pair
+//  Directions and orientations are given as structure-of-arrays. The conversion is branch-free, so the compiler can vectorize it.
+//  To orient cameras of a pool, pass the pool orientation arrays (ex. _pool->orientation_x + _first) as output.
+// Note: the forward directions are expected to be normalized
+extern void camera_look_at_batch(const float* _forward_x, const float* _forward_y, const float* _forward_z,
+    const float* _up_x, const float* _up_y, const float* _up_z, uint32_t _count,
+    float* _out_x, float* _out_y, float* _out_z, float* _out_w);
+
 // Update the camera and generate a view matrix
 // Note: _out_matrix is expected to be a float[16]
 extern void camera_view_matrix(Camera* _cam, float* _out_matrix);
 
+// Returns an output description, see CameraOutput
+extern CameraOutput camera_output(void* _data, uint32_t _stride, uint32_t _flags);
 
-#endif // !CAMERA_HEADER_GUARD
+// Same as camera_view_matrix(..), but writes the matrix to _output->data as described by _output
+extern void camera_view_matrix_output(Camera* _cam, const CameraOutput* _output);
 
+// Generate a view matrix between the last two camera_view_matrix(..) calls without updating the camera
+//  _alpha = 0 reproduces the view of the previous call, _alpha = 1 the view of the last call.
+//  Meant for a fixed simulation step: call camera_view_matrix(..) once per step and this once per rendered frame,
+//   with _alpha being the fraction of the step elapsed since the last simulation step.
+// Note: _out_matrix is expected to be a float[16]
+extern void camera_view_matrix_interpolated(const Camera* _cam, float _alpha, float* _out_matrix);
 
-#ifdef CAMERA_IMPLEMENTATION
+// Returns the spring coefficients smoothing the view over a time step of _dt seconds
+//  Each _*_time is the smoothing time in seconds of a critically damped spring: a sudden change of the camera state
+//   is followed to within 10% after twice and within 2% after three times the smoothing time. 0 disables a spring.
+//  Call it once per distinct _dt (ex. once for a fixed time step), not per camera and frame.
+extern CameraSmoothing camera_smoothing(float _position_time, float _distance_time, float _orientation_time, float _dt);
 
-extern Camera camera_init()
-{
-    static Camera cam = {
-        .target_position = cm_init_vec3(0.0f, 0.0f, 0.0f),
-        .target_distance = 0.0f,
-        .orientation = cm_init_quat(0.0f, 0.0f, 0.0, 0.0f),
-        .mode = CAMERA_MODE_FREE,
+// Returns the boom configuration for a time step of _dt seconds
+//  The eye is kept _radius away from the hit geometry, but never closer than _min_distance to the view position.
+//  Each _*_time is the time in seconds to close 63% of the gap after the hit distance changed (95% after three times).
+//  0 moves at once, which suits _in_time: the eye should not stay inside a wall.
+extern CameraBoom camera_boom(float _radius, float _min_distance, float _in_time, float _out_time, float _dt);
 
-        .movement_accumulator = cm_init_vec3(0.0f, 0.0f, 0.0f),
-        .rotation_accumulator = cm_init_vec3(0.0f, 0.0f, 0.0f),
+// Returns the ray to query for the boom of _cam
+//  Built from the view state of the last camera_view_matrix(..).
+extern CameraBoomRay camera_boom_ray(const Camera* _cam, const CameraBoom* _boom);
 
-        .minPitch = 0.0f,
-        .maxPitch = 0.0f,
-        .minYaw = 0.0f,
-        .maxYaw = 0.0f,
-        .minRoll = 0.0f,
-        .maxRoll = 0.0f,
-    };
+// Move camera.boom_distance one time step towards the result of a ray query
+//  _hit_distance is the distance to the first hit along the ray of camera_boom_ray(..), or its length if nothing was hit.
+//  It does not have to be from this frame: query after this frame's update and apply before the next one.
+//  The boom turns off once it is let out to the view distance.
+extern void camera_boom_apply(Camera* _cam, const CameraBoom* _boom, float _hit_distance);
 
-    return cam;
-};
+// Same as camera_boom_ray(..) for all cameras in the pool, handing all rays to _query in one call
+//  _out_rays and _out_hit_distances are passed to _query and have to stay valid until it wrote the results.
+//  Ex. request after camera_view_matrix_batch(..), then pass _out_hit_distances to camera_boom_apply_batch(..) next frame.
+// Note: _out_rays and _out_hit_distances are expected to hold _pool->count elements
+extern void camera_boom_request_batch(const CameraPool* _pool, const CameraBoom* _boom, CameraBoomRay* _out_rays, float* _out_hit_distances,
+    CameraBoomQueryFn _query, void* _user);
 
-extern CameraVec3 camera_forward(const Camera* _cam)
-{
-    return cm_mul(CAMERA_WORLD_FORWARD, cm_invert(_cam->orientation));
-};
+// Same as camera_boom_apply(..) for all cameras in the pool
+// Note: _hit_distances is expected to hold _pool->count elements, in the order of the cameras when they were requested
+extern void camera_boom_apply_batch(CameraPool* _pool, const CameraBoom* _boom, const float* _hit_distances);
 
-extern CameraVec3 camera_up(const Camera* _cam)
-{
-    return cm_mul(CAMERA_WORLD_UP, cm_invert(_cam->orientation));
-};
+// Returns the number of bytes required for a camera pool holding _capacity cameras
+extern size_t camera_pool_memory_size(uint32_t _capacity);
 
-extern CameraVec3 camera_right(const Camera* _cam)
-{
-    return cm_mul(CAMERA_WORLD_RIGHT, cm_invert(_cam->orientation));
-};
+// Initialize an empty camera pool in _memory
+//  The pool does not allocate, it only partitions _memory into its arrays.
+// Note: _memory is expected to be aligned to CAMERA_POOL_ALIGNMENT and hold camera_pool_memory_size(_capacity) bytes
+extern CameraPool camera_pool_init(void* _memory, uint32_t _capacity);
 
-extern CameraVec3 camera_eye(const Camera* _cam)
-{
-    return cm_add(_cam->target_position, cm_scale(camera_forward(_cam), -_cam->target_distance));
-};
+// Append a copy of _cam to the pool
+//  Returns the index of the new camera or UINT32_MAX if the pool is full
+extern uint32_t camera_pool_add(CameraPool* _pool, const Camera* _cam);
 
-extern void camera_move(Camera* _cam, const CameraVec3 _offset)
-{
-    _cam->movement_accumulator = cm_add(_cam->movement_accumulator, _offset);
-}
+// Remove the camera at _index
+//  The last camera is moved into the freed slot to keep the pool dense.
+extern void camera_pool_remove(CameraPool* _pool, uint32_t _index);
 
-extern void camera_rotate(Camera* _cam, const CameraVec3 _angles)
-{
-    _cam->rotation_accumulator = cm_add(_cam->rotation_accumulator, _angles);
-}
+// Returns a copy of the camera at _index
+extern Camera camera_pool_get(const CameraPool* _pool, uint32_t _index);
 
-extern void camera_look_at(Camera* _cam, CameraVec3 _forward, CameraVec3 _up)
-{
-    // Based on typical vector to matrix to quaternion approach
+// Overwrite the camera at _index with _cam
+extern void camera_pool_set(CameraPool* _pool, uint32_t _index, const Camera* _cam);
 
-    // Get orthogonal basis vectors
-    const CameraVec3 right = cm_normalizeVec3(cm_cross(_up, _forward));
-    _up = cm_cross(_forward, right);
+// Same as camera_move(..) for the camera at _index
+extern void camera_pool_move(CameraPool* _pool, uint32_t _index, const CameraVec3 _offset);
 
-    // Convert to Quaternion
-    // Ref.: https://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/
+// Same as camera_rotate(..) for the camera at _index
+extern void camera_pool_rotate(CameraPool* _pool, uint32_t _index, const CameraVec3 _angles);
 
-    const float m0 = right.x;
-    const float m1 = right.y;
-    const float m2 = right.z;
+// Same as camera_mark_dirty(..) for the camera at _index
+extern void camera_pool_mark_dirty(CameraPool* _pool, uint32_t _index);
 
-    const float m4 = _up.x;
-    const float m5 = _up.y;
-    const float m6 = _up.z;
+// Update all cameras in the pool and generate their view matrices
+//  Identical to calling camera_view_matrix(..) for every camera, see "Camera Pool".
+// Note: _out_matrices is expected to be a float[16 * _pool->count]
+extern void camera_view_matrix_batch(CameraPool* _pool, float* _out_matrices);
 
-    const float m8 = _forward.x;
-    const float m9 = _forward.y;
-    const float m10 = _forward.z;
+// Same as camera_view_matrix_interpolated(..) for all cameras in the pool
+// Note: _out_matrices is expected to be a float[16 * _pool->count]
+extern void camera_view_matrix_interpolated_batch(const CameraPool* _pool, float _alpha, float* _out_matrices);
 
-    float trace = m0 + m5 + m10;
-    if (trace > 0)
-    {
-        float s = 0.5f / cm_sqrt(trace + 1.0f);
-        _cam->orientation.w = 0.25f / s;
-        _cam->orientation.x = (m6 - m9) * s;
-        _cam->orientation.y = (m8 - m2) * s;
-        _cam->orientation.z = (m1 - m4) * s;
-    }
-    else {
-        if (m0 > m5 && m0 > m10)
-        {
-            float s = 2.0f * cm_sqrt(1.0f + m0 - m5 - m10);
-            _cam->orientation.w = (m6 - m9) / s;
-            _cam->orientation.x = 0.25f * s;
-            _cam->orientation.y = (m4 + m1) / s;
-            _cam->orientation.z = (m8 + m2) / s;
-        }
-        else if (m5 > m10)
-        {
-            float s = 2.0f * cm_sqrt(1.0f + m5 - m0 - m10);
-            _cam->orientation.w = (m8 - m2) / s;
-            _cam->orientation.x = (m4 + m1) / s;
-            _cam->orientation.y = 0.25f * s;
-            _cam->orientation.z = (m9 + m6) / s;
-        }
-        else
-        {
-            float s = 2.0f * cm_sqrt(1.0f + m10 - m0 - m5);
-            _cam->orientation.w = (m1 - m4) / s;
-            _cam->orientation.x = (m8 + m2) / s;
-            _cam->orientation.y = (m9 + m6) / s;
-            _cam->orientation.z = 0.25f * s;
-        }
-    }
-}
+// Same as camera_view_matrix_batch(..), but camera i writes its matrix as described by _output to (uint8_t*)_output->data + i * _output->stride
+extern void camera_view_matrix_batch_output(CameraPool* _pool, const CameraOutput* _output);
 
-extern void camera_view_matrix(Camera* _cam, float* _out_matrix)
-{
-    /* Clamp angles */
+// Update the cameras [_begin; _end) of the pool and generate their view matrices
+//  Camera i writes its matrix to _out_matrices + 16 * i. _end is clamped to _pool->count.
+//  Disjoint ranges can be updated concurrently. If _begin and _end are multiples of CAMERA_POOL_LANES
+//   and _out_matrices is aligned to CAMERA_POOL_ALIGNMENT, no two ranges share a cache line.
+// Note: _out_matrices is expected to be a float[16 * _pool->count]
+extern void camera_pool_update(CameraPool* _pool, uint32_t _begin, uint32_t _end, float* _out_matrices);
 
-    if (_cam->mode & (CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE))
-    {
-        const CameraVec3 angles = cm_toEuler(_cam->orientation);
+// Same as camera_pool_update(..), but writes the matrices as described by _output, see camera_view_matrix_batch_output(..)
+extern void camera_pool_update_output(CameraPool* _pool, uint32_t _begin, uint32_t _end, const CameraOutput* _output);
 
-        if (_cam->mode & CAMERA_MODE_CLAMP_PITCH_ANGLE)
-        {
-            _cam->rotation_accumulator.x = cm_max(_cam->minPitch - angles.x, _cam->rotation_accumulator.x);
-            _cam->rotation_accumulator.x = cm_min(_cam->maxPitch - angles.x, _cam->rotation_accumulator.x);
-        }
+// Returns a parallel update of all cameras in the pool
+//  _chunk_size is rounded up to a multiple of CAMERA_POOL_LANES, 0 selects CAMERA_POOL_LANES.
+// Note: _out_matrices is expected to be a float[16 * _pool->count]
+extern CameraPoolJob camera_pool_job(CameraPool* _pool, float* _out_matrices, uint32_t _chunk_size);
 
-        if (_cam->mode & CAMERA_MODE_CLAMP_YAW_ANGLE)
-        {
-            _cam->rotation_accumulator.y = cm_max(_cam->minYaw - angles.y, _cam->rotation_accumulator.y);
-            _cam->rotation_accumulator.y = cm_min(_cam->maxYaw - angles.y, _cam->rotation_accumulator.y);
-        }
+// Claim and update chunks of the job until none are left
+//  Safe to call from any number of threads at once. Returns the number of cameras updated by this call.
+extern uint32_t camera_pool_job_run(CameraPoolJob* _job);
 
-        if (_cam->mode & CAMERA_MODE_CLAMP_ROLL_ANGLE)
-        {
-            _cam->rotation_accumulator.z = cm_max(_cam->minRoll - angles.z, _cam->rotation_accumulator.z);
-            _cam->rotation_accumulator.z = cm_min(_cam->maxRoll - angles.z, _cam->rotation_accumulator.z);
-        }
-    }
+// Update all cameras in the pool on _worker_count workers provided by _dispatch
+//  Identical to camera_view_matrix_batch(..), returns once all cameras are updated.
+// Note: _out_matrices is expected to be a float[16 * _pool->count]
+extern void camera_view_matrix_parallel(CameraPool* _pool, float* _out_matrices, uint32_t _chunk_size,
+    uint32_t _worker_count, CameraPoolDispatchFn _dispatch, void* _user);
 
+// Returns the number of bytes required for a camera registry holding _capacity cameras
+extern size_t camera_registry_memory_size(uint32_t _capacity);
 
-    /* Update orientation */
+// Initialize an empty camera registry in _memory
+//  Like the pool, the registry does not allocate.
+// Note: _memory is expected to be aligned to CAMERA_POOL_ALIGNMENT and hold camera_registry_memory_size(_capacity) bytes
+extern CameraRegistry camera_registry_init(void* _memory, uint32_t _capacity);
 
-    const CameraQuat pitch = cm_fromAxisAngle(CAMERA_WORLD_RIGHT, _cam->rotation_accumulator.x);
-    const CameraQuat yaw = cm_fromAxisAngle(CAMERA_WORLD_UP, _cam->rotation_accumulator.y);
+// Append a copy of _cam to the registry pool
+//  Returns its handle or a zero-initialized handle if the registry is full. Slots of destroyed cameras are reused first.
+extern CameraHandle camera_registry_create(CameraRegistry* _registry, const Camera* _cam);
 
-    if (_cam->mode & CAMERA_MODE_DISABLE_ROLL)
-    {
-        // Note: The multiplication order is important, not to induce roll from pitch+yaw
-        _cam->orientation = cm_mulQuat(_cam->orientation, pitch);
-        _cam->orientation = cm_mulQuat(yaw, _cam->orientation);
-    }
-    else
-    {
-        const CameraQuat roll = cm_fromAxisAngle(CAMERA_WORLD_FORWARD, _cam->rotation_accumulator.z);
+// Destroy the camera of _handle, invalidating the handle
+//  The last camera of the pool is moved into the freed place. Invalid handles are ignored.
+extern void camera_registry_destroy(CameraRegistry* _registry, CameraHandle _handle);
 
-        _cam->orientation = cm_mulQuat(_cam->orientation, pitch);
-        _cam->orientation = cm_mulQuat(_cam->orientation, yaw);
-        _cam->orientation = cm_mulQuat(_cam->orientation, roll);
-    }
+// Returns true if _handle refers to a live camera
+extern bool camera_registry_valid(const CameraRegistry* _registry, CameraHandle _handle);
 
-    _cam->orientation = cm_normalizeQuat(_cam->orientation); // Re-Normalize orientation quaternion
+// Returns the pool index of the camera of _handle or UINT32_MAX if the handle is invalid
+//  The index is only valid until the next camera_registry_create(..), camera_registry_destroy(..) or camera_registry_compact(..).
+extern uint32_t camera_registry_index(const CameraRegistry* _registry, CameraHandle _handle);
 
-    // Reset accumulator
-    _cam->rotation_accumulator.x = 0.0f;
-    _cam->rotation_accumulator.y = 0.0f;
-    _cam->rotation_accumulator.z = 0.0f;
+// Returns the handle of the camera at pool index _index, ex. to find the camera of a batch output
+extern CameraHandle camera_registry_handle(const CameraRegistry* _registry, uint32_t _index);
 
+// Reorder the pool so cameras of the same mode are adjacent, in ascending mode order and otherwise in their current order
+//  Records the groups in _registry->groups and returns their number. Handles stay valid, pool indices change.
+//  Cameras of modes beyond the first CAMERA_REGISTRY_MAX_GROUPS - 1 share a last group of CAMERA_REGISTRY_MIXED_MODE.
+//  Costs O(count) and moves no camera if the pool is already grouped. Call it after creating or destroying cameras
+//   or changing their mode, ex. once per frame before the update.
+extern uint32_t camera_registry_compact(CameraRegistry* _registry);
 
-    /* Update target_position */
+#if defined(__cplusplus)
+// Camera modes the mode specializations below are instantiated for: _apply(mode)
+//  Define CAMERA_SPECIALIZED_MODES before including 'camera.h' with CAMERA_IMPLEMENTATION to specialize your own modes.
+// Note: CAMERA_MODE_THIRD_PERSON is the same mode as CAMERA_MODE_FIRST_PERSON
+#ifndef CAMERA_SPECIALIZED_MODES
+#define CAMERA_SPECIALIZED_MODES(_apply) \
+    _apply(CAMERA_MODE_FREE) \
+    _apply(CAMERA_MODE_FIRST_PERSON) \
+    _apply(CAMERA_MODE_ORBITAL)
+#endif
 
-    CameraVec3 forward = camera_forward(_cam);
-    CameraVec3 up = camera_up(_cam);
-    CameraVec3 right = camera_right(_cam);
+// Same as camera_view_matrix(..), camera_pool_update(..) and camera_view_matrix_batch(..),
+//  but specialized for the compile-time mode Mode. All mode branches are resolved when compiling.
+//  Cameras are updated as Mode regardless of camera.mode, which is expected to be Mode.
+//  Ex. group the cameras of a pool by mode and update every group with its specialization.
+// Note: Only available for the modes in CAMERA_SPECIALIZED_MODES
+template <uint32_t Mode> void camera_view_matrix(Camera* _cam, float* _out_matrix);
+template <uint32_t Mode> void camera_pool_update(CameraPool* _pool, uint32_t _begin, uint32_t _end, float* _out_matrices);
+template <uint32_t Mode> void camera_view_matrix_batch(CameraPool* _pool, float* _out_matrices);
+#endif
 
-    if (_cam->mode & CAMERA_MODE_MOVE_IN_WORLDPLANE)
-    {
-        const float epsilon = 0.0001f; // Avoid floating point errors
+// Returns a perspective projection
+//  _flags = CAMERA_PROJECTION_PERSPECTIVE combined with any CAMERA_PROJECTION_* configuration flags
+// Note: _fov_y is expected in radians
+extern CameraProjection camera_projection_perspective(float _fov_y, float _aspect, float _near, float _far, uint32_t _flags);
 
-        if (forward.y > 1.0f - epsilon) // Note: forward is normalized, so checking .y is sufficent
-        { // Special case: Looking straight up
-            forward = cm_negate(up);
-        }
-        else if (forward.y < -1.0f + epsilon)
-        { // Special case: Looking straight down
-            forward = up;
-        }
-        else if (right.y > 1.0f - epsilon)
-        {
-            right = up;
-        }
-        else if (right.y < -1.0f + epsilon)
-        {
-            right = cm_negate(up);
-        }
+// Returns an orthographic projection
+//  _flags = CAMERA_PROJECTION_ORTHOGRAPHIC is implied, CAMERA_PROJECTION_INFINITE_FAR is ignored
+extern CameraProjection camera_projection_orthographic(float _height, float _aspect, float _near, float _far, uint32_t _flags);
 
-        // Project the forward and right into the world plane
-        forward.y = 0;
-        forward = cm_normalizeVec3(forward);
+// Generate a projection matrix
+// Note: _out_matrix is expected to be a float[16]
+extern void camera_projection_matrix(const CameraProjection* _proj, float* _out_matrix);
 
-        right.y = 0;
-        right = cm_normalizeVec3(right);
+// Update the camera and generate all of its matrices
+//  Same update as camera_view_matrix(..). The inverses are built analytically from the orthonormal camera basis
+//  and the sparse projection, no general 4x4 multiplication or inversion is involved.
+extern void camera_matrices(Camera* _cam, const CameraProjection* _proj, CameraMatrices* _out);
 
-        up = CAMERA_WORLD_UP;
-    }
+// Returns temporal matrices without a previous frame, see CameraTemporal
+extern CameraTemporal camera_temporal(uint32_t _jitter_length);
 
-    // Scale by desired distance
-    forward = cm_scale(forward, _cam->movement_accumulator.x);
-    up = cm_scale(up, _cam->movement_accumulator.y);
-    right = cm_scale(right, _cam->movement_accumulator.z);
+// Update the camera and generate its temporal matrices for a _width x _height pixel render target
+//  Same update as camera_view_matrix(..). The reprojection is composed from the rigid transform between the two views
+//  and the sparse projections, no general 4x4 multiplication or inversion is involved.
+//  On the first call the previous frame is the current one, so the reprojection is the identity.
+extern void camera_temporal_matrices(Camera* _cam, const CameraProjection* _proj, uint32_t _width, uint32_t _height, CameraTemporal* _temporal);
 
-    // Apply changes to target_position
-    _cam->target_position = cm_add(_cam->target_position, forward);
-    _cam->target_position = cm_add(_cam->target_position, up);
-    _cam->target_position = cm_add(_cam->target_position, right);
+// Returns element _index of the Halton low-discrepancy sequence of _base within [0; 1)
+extern float camera_halton(uint32_t _index, uint32_t _base);
+// Extract the world space frustum planes from a view projection matrix
+//  _projection_flags are the CameraProjection.flags the matrix was generated with (they define the depth range).
+// Note: _view_projection is expected to be a float[16], ex. CameraMatrices.view_projection
+extern CameraFrustum camera_frustum(const float* _view_projection, uint32_t _projection_flags);
 
-    // Reset accumulator
-    _cam->movement_accumulator.x = 0.0f;
-    _cam->movement_accumulator.y = 0.0f;
-    _cam->movement_accumulator.z = 0.0f;
+// Test bounding spheres against a frustum
+//  Spheres are given as structure-of-arrays (center _x, _y, _z and _radius).
+//  Bit (i % 32) of _out_visible[i / 32] is set if sphere i intersects the frustum.
+//  _last_plane is an optional coherency hint (may be NULL): one byte per sphere, initialized to 0,
+//   storing the plane that rejected it last, which is tested first next time.
+//   Without hint the spheres are tested branch-free in blocks, which allows the compiler to vectorize the tests.
+// Note: _out_visible is expected to be a uint32_t[(_count + 31) / 32]
+extern void camera_cull_spheres(const CameraFrustum* _frustum, const float* _x, const float* _y, const float* _z, const float* _radius, uint32_t _count, uint32_t* _out_visible, uint8_t* _last_plane);
 
+// Test axis aligned bounding boxes against a frustum
+//  Boxes are given as structure-of-arrays (center _x, _y, _z and half extents _ex, _ey, _ez).
+//  Output and coherency hint are the same as for camera_cull_spheres(..).
+// Note: _out_visible is expected to be a uint32_t[(_count + 31) / 32]
+extern void camera_cull_aabbs(const CameraFrustum* _frustum, const float* _x, const float* _y, const float* _z, const float* _ex, const float* _ey, const float* _ez, uint32_t _count, uint32_t* _out_visible, uint8_t* _last_plane);
 
-    /* Generate view matrix */
+// Returns a level of detail configuration of _count levels
+//  _count is clamped to [1; CAMERA_LOD_LEVELS].
+// Note: _pixel_radius is expected to hold _count - 1 descending thresholds
+extern CameraLod camera_lod(const float* _pixel_radius, uint32_t _count, float _hysteresis);
 
-    // Get rotation matrix
-    cm_matrixFromQuat(_out_matrix, _cam->orientation);
+// Select the level of detail of bounding spheres
+//  Spheres are given as structure-of-arrays (center _x, _y, _z and _radius), relative to the same origin as the camera.
+//  Measured from camera.eye of the last camera_view_matrix(..), the camera is not updated.
+//  _out_distance_sq receives the squared distance to the eye, _out_pixel_radius the projected radius in pixels
+//   for a viewport of _viewport_height pixels. Both are optional (may be NULL).
+//  _levels holds the level of every sphere. It is read for the hysteresis and overwritten with the new level.
+//  Initialize it to 0 for new spheres.
+// Note: The projected radius of perspective projections is radius / distance, the distance is clamped to at least the radius
+extern void camera_lod_select(const Camera* _cam, const CameraProjection* _proj, float _viewport_height, const CameraLod* _lod,
+    const float* _x, const float* _y, const float* _z, const float* _radius, uint32_t _count,
+    float* _out_distance_sq, float* _out_pixel_radius, uint8_t* _levels);
+
+// Generate the left and right eye view matrices of a stereo camera
+//  Derived from the last camera_view_matrix(..): the eyes are offset by -+_ipd / 2 along camera.right.
+// Note: _out_matrices is expected to be a float[32] (left eye followed by the right eye)
+extern void camera_stereo_views(const Camera* _cam, float _ipd, float* _out_matrices);
+
+// Generate the view matrices of the six cube map faces around camera.eye
+//  The faces look along the world axes in CAMERA_CUBE_* order with the usual (left-handed) cube map up vectors.
+//  Render them with a 90 degree perspective projection of aspect 1.
+// Note: _out_matrices is expected to be a float[16 * CAMERA_CUBE_FACES]
+extern void camera_cube_views(const Camera* _cam, float* _out_matrices);
+
+// Generate the orthographic light views of cascaded shadow maps covering the view of the camera
+//  Cascade i covers view depth [_splits[i]; _splits[i + 1]] of the camera with projection _proj and looks along _light_direction.
+//  Each is fitted to the bounding sphere of its part of the view volume, so its size does not change when the camera rotates.
+//  With a _resolution > 2 the cascades move in whole shadow map texels, which avoids shimmering edges (0 disables it).
+//  The depth range of _out_projections is the bounding sphere. Lower its near_plane to include casters outside the view volume.
+// Note: _light_direction is expected to be normalized, _splits to be a float[_cascade_count + 1]
+// Note: _out_matrices is expected to be a float[16 * _cascade_count], _out_projections a CameraProjection[_cascade_count]
+extern void camera_cascade_views(const Camera* _cam, const CameraProjection* _proj, CameraVec3 _light_direction,
+    const float* _splits, uint32_t _cascade_count, uint32_t _resolution, float* _out_matrices, CameraProjection* _out_projections);
+
+#if defined(CAMERA_PROFILE)
+// Returns the profile counters of the calling thread
+//  Counters are only ever incremented. Sum them across your worker threads as needed.
+extern CameraProfileCounters* camera_profile_counters(void);
+
+// Reset the profile counters of the calling thread to zero
+extern void camera_profile_reset(void);
+#endif
+
+// Returns a packing with the given quantization, see CameraPacking
+extern CameraPacking camera_packing(float _position_step, float _max_distance);
 
-    // Add translation
-    CameraVec3 translation = cm_negate(camera_eye(_cam));
+// Returns the replicated subset of _cam
+//  Values outside of the packing range are clamped.
+extern CameraPacked camera_pack(const Camera* _cam, const CameraPacking* _packing);
 
-    translation = cm_mul(translation, _cam->orientation);
+// Overwrite target_position, target_distance and orientation of _cam with the packed state
+//  All other members are kept, so mode and limits stay as set up on the receiving side.
+//  The changes are applied by the next camera_view_matrix(..) as with any direct manipulation.
+// Note: _cam is expected to be initialized (ex. by camera_init(..))
+extern void camera_unpack(const CameraPacked* _packed, const CameraPacking* _packing, Camera* _cam);
 
-    _out_matrix[12] = translation.x;
-    _out_matrix[13] = translation.y;
-    _out_matrix[14] = translation.z;
+// Same as camera_pack(..) for _count cameras of the pool
+//  _indices selects the cameras. If it is NULL, the cameras [0; _count) are packed.
+// Note: _out is expected to be a CameraPacked[_count]
+extern void camera_pool_pack(const CameraPool* _pool, const uint32_t* _indices, uint32_t _count, const CameraPacking* _packing, CameraPacked* _out);
 
+// Same as camera_unpack(..) for _count cameras of the pool
+//  _indices selects the cameras. If it is NULL, the cameras [0; _count) are overwritten.
+// Note: _packed is expected to be a CameraPacked[_count] and the selected cameras to exist in the pool
+extern void camera_pool_unpack(const CameraPacked* _packed, const uint32_t* _indices, uint32_t _count, const CameraPacking* _packing, CameraPool* _pool);
+
+#endif // !CAMERA_HEADER_GUARD
+
+
+#ifdef CAMERA_IMPLEMENTATION
+
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CAMERA__STREAMING_STORES
+#endif
+
+#if defined(_MSC_VER)
+#define CAMERA__FORCE_INLINE __forceinline
+#elif defined(__GNUC__)
+#define CAMERA__FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define CAMERA__FORCE_INLINE inline
+#endif
+
+#if defined(CAMERA_PROFILE)
+#if defined(__cplusplus)
+static thread_local CameraProfileCounters camera__profile;
+#elif defined(_MSC_VER)
+static __declspec(thread) CameraProfileCounters camera__profile;
+#else
+static _Thread_local CameraProfileCounters camera__profile;
+#endif
+
+#define CAMERA__PROFILE_COUNT(_counter, _amount) (camera__profile._counter += (_amount))
+#define CAMERA__PROFILE_BEGIN(_phase, _name) camera__profile.phases[_phase]++; CAMERA_PROFILE_BEGIN(_name)
+#define CAMERA__PROFILE_END(_name) CAMERA_PROFILE_END(_name)
+#else
+#define CAMERA__PROFILE_COUNT(_counter, _amount)
+#define CAMERA__PROFILE_BEGIN(_phase, _name)
+#define CAMERA__PROFILE_END(_name)
+#endif
+
+// Add _value to an accumulator component
+//  With CAMERA_CONCURRENT_INPUT this is a lock-free atomic add, safe to call from any thread.
+static inline void camera__accumulate(float* _accumulator, float _value)
+{
+#if defined(CAMERA_CONCURRENT_INPUT)
+#if defined(_MSC_VER)
+    volatile long* bits = (volatile long*)_accumulator;
+    long expected = *bits;
+    for (;;)
+    {
+        float sum = *(const float*)&expected + _value;
+        const long previous = _InterlockedCompareExchange(bits, *(const long*)&sum, expected);
+        if (previous == expected)
+        {
+            break;
+        }
+        expected = previous;
+    }
+#else
+    float expected;
+    __atomic_load(_accumulator, &expected, __ATOMIC_RELAXED);
+    float sum = expected + _value;
+    while (!__atomic_compare_exchange(_accumulator, &expected, &sum, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+        sum = expected + _value;
+    }
+#endif
+#else
+    *_accumulator += _value;
+#endif
+}
+
+// Atomically advance *_cursor by _amount, returns the previous value
+static inline uint32_t camera__claim(uint32_t* _cursor, uint32_t _amount)
+{
+#if defined(_MSC_VER)
+    return (uint32_t)_InterlockedExchangeAdd((volatile long*)_cursor, (long)_amount);
+#else
+    return __atomic_fetch_add(_cursor, _amount, __ATOMIC_RELAXED);
+#endif
+}
+
+// Set a dirty flag and call _on_change if it was clear
+//  With CAMERA_CONCURRENT_INPUT this is an atomic exchange, so exactly one of many concurrent calls reports the change.
+static inline void camera__mark_dirty(uint32_t* _dirty, CameraChangeFn _on_change, void* _user)
+{
+#if defined(CAMERA_CONCURRENT_INPUT)
+#if defined(_MSC_VER)
+    const uint32_t previous = (uint32_t)_InterlockedExchange((volatile long*)_dirty, 1);
+#else
+    const uint32_t previous = __atomic_exchange_n(_dirty, 1u, __ATOMIC_ACQ_REL);
+#endif
+#else
+    const uint32_t previous = *_dirty;
+    *_dirty = 1;
+#endif
+    if (previous == 0 && _on_change != NULL)
+    {
+        _on_change(_user);
+    }
+}
+
+// Clear a dirty flag before the input of its camera is drained
+//  Input added after the drain marks the camera (and reports the change) again, so no change goes unnoticed.
+static inline void camera__clear_dirty(uint32_t* _dirty)
+{
+#if defined(CAMERA_CONCURRENT_INPUT)
+#if defined(_MSC_VER)
+    _InterlockedExchange((volatile long*)_dirty, 0);
+#else
+    __atomic_exchange_n(_dirty, 0u, __ATOMIC_ACQ_REL);
+#endif
+#else
+    *_dirty = 0;
+#endif
+}
+
+extern CameraPoolJob camera_pool_job(CameraPool* _pool, float* _out_matrices, uint32_t _chunk_size)
+{
+    const uint32_t chunk_size = _chunk_size == 0 ? CAMERA_POOL_LANES : _chunk_size;
+
+    CameraPoolJob job;
+    job.pool = _pool;
+    job.out_matrices = _out_matrices;
+    job.chunk_size = (chunk_size + CAMERA_POOL_LANES - 1) / CAMERA_POOL_LANES * CAMERA_POOL_LANES;
+    job.end = _pool->count;
+    job.next = 0;
+    return job;
+}
+
+extern uint32_t camera_pool_job_run(CameraPoolJob* _job)
+{
+    uint32_t updated = 0;
+    for (;;)
+    {
+        // Note: Claiming past the end never wraps, as end + workers * chunk_size stays far below UINT32_MAX for any pool that fits into memory
+        const uint32_t begin = camera__claim(&_job->next, _job->chunk_size);
+        if (begin >= _job->end)
+        {
+            break;
+        }
+
+        const uint32_t end = begin + _job->chunk_size < _job->end ? begin + _job->chunk_size : _job->end;
+        camera_pool_update(_job->pool, begin, end, _job->out_matrices);
+        updated += end - begin;
+    }
+    return updated;
+}
+
+static void camera__pool_job_run(void* _job)
+{
+    camera_pool_job_run((CameraPoolJob*)_job);
+}
+
+extern void camera_view_matrix_parallel(CameraPool* _pool, float* _out_matrices, uint32_t _chunk_size,
+    uint32_t _worker_count, CameraPoolDispatchFn _dispatch, void* _user)
+{
+    CameraPoolJob job = camera_pool_job(_pool, _out_matrices, _chunk_size);
+    if (_dispatch == NULL || _worker_count <= 1)
+    {
+        camera_pool_job_run(&job);
+        return;
+    }
+
+    _dispatch(_user, _worker_count, camera__pool_job_run, &job);
+}
+
+// Take the value out of an accumulator component, leaving it zero
+//  With CAMERA_CONCURRENT_INPUT this is an atomic exchange, so no concurrently added input is lost.
+static inline float camera__drain_component(float* _accumulator)
+{
+#if defined(CAMERA_CONCURRENT_INPUT)
+#if defined(_MSC_VER)
+    const long previous = _InterlockedExchange((volatile long*)_accumulator, 0);
+    return *(const float*)&previous;
+#else
+    float zero = 0.0f;
+    float previous;
+    __atomic_exchange(_accumulator, &zero, &previous, __ATOMIC_RELAXED);
+    return previous;
+#endif
+#else
+    const float previous = *_accumulator;
+    *_accumulator = 0.0f;
+    return previous;
+#endif
+}
+
+static inline CameraVec3 camera__drain(CameraVec3* _accumulator)
+{
+    const float x = camera__drain_component(&_accumulator->x);
+    const float y = camera__drain_component(&_accumulator->y);
+    const float z = camera__drain_component(&_accumulator->z);
+    return cm_init_vec3(x, y, z);
+}
+
+extern Camera camera_init()
+{
+    static Camera cam = {
+        .target_position = cm_init_vec3(0.0f, 0.0f, 0.0f),
+        .target_distance = 0.0f,
+        .orientation = cm_init_quat(0.0f, 0.0f, 0.0f, 1.0f),
+        .mode = CAMERA_MODE_FREE,
+
+        .movement_accumulator = cm_init_vec3(0.0f, 0.0f, 0.0f),
+        .rotation_accumulator = cm_init_vec3(0.0f, 0.0f, 0.0f),
+
+        .dirty = 1,
+        .on_change = NULL,
+        .on_change_user = NULL,
+
+        .minPitch = 0.0f,
+        .maxPitch = 0.0f,
+        .minYaw = 0.0f,
+        .maxYaw = 0.0f,
+        .minRoll = 0.0f,
+        .maxRoll = 0.0f,
+
+        .smoothing = NULL,
+
+        .boom_distance = CAMERA_BOOM_OFF,
+
+        .forward = CAMERA_WORLD_FORWARD,
+        .up = CAMERA_WORLD_UP,
+        .right = CAMERA_WORLD_RIGHT,
+        .eye = cm_init_vec3(0.0f, 0.0f, 0.0f),
+
+        .angles = cm_init_vec3(0.0f, 0.0f, 0.0f),
+
+        .applied_position = cm_init_vec3(0.0f, 0.0f, 0.0f),
+        .applied_distance = 0.0f,
+        .applied_orientation = cm_init_quat(0.0f, 0.0f, 0.0f, 1.0f),
+        .applied_mode = CAMERA_MODE_FREE,
+        .applied_limits = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f },
+        .applied_boom_distance = CAMERA_BOOM_OFF,
+
+        .view_position = cm_init_vec3(0.0f, 0.0f, 0.0f),
+        .view_distance = 0.0f,
+        .view_orientation = cm_init_quat(0.0f, 0.0f, 0.0f, 1.0f),
+
+        .position_velocity = cm_init_vec3(0.0f, 0.0f, 0.0f),
+        .distance_velocity = 0.0f,
+        .orientation_velocity = cm_init_quat(0.0f, 0.0f, 0.0f, 0.0f),
+
+        .previous_position = cm_init_vec3(0.0f, 0.0f, 0.0f),
+        .previous_distance = 0.0f,
+        .previous_orientation = cm_init_quat(0.0f, 0.0f, 0.0f, 1.0f),
+
+        .generation = 0,
+
+        .origin = { 0, 0, 0 },
+        .origin_generation = 0,
+    };
+
+    return cam;
+};
+
+extern CameraVec3 camera_forward(const Camera* _cam)
+{
+    return _cam->forward;
+};
+
+extern CameraVec3 camera_up(const Camera* _cam)
+{
+    return _cam->up;
+};
+
+extern CameraVec3 camera_right(const Camera* _cam)
+{
+    return _cam->right;
+};
+
+extern CameraVec3 camera_eye(const Camera* _cam)
+{
+    return _cam->eye;
+};
+
+// Move the origin by _cells, keeping all positions of the camera at the same world position
+static inline void camera__shift_origin(Camera* _cam, const int32_t* _cells)
+{
+    const CameraVec3 shift = cm_init_vec3(
+        (float)_cells[0] * -CAMERA_ORIGIN_CELL_SIZE,
+        (float)_cells[1] * -CAMERA_ORIGIN_CELL_SIZE,
+        (float)_cells[2] * -CAMERA_ORIGIN_CELL_SIZE);
+
+    _cam->target_position = cm_add(_cam->target_position, shift);
+    _cam->view_position = cm_add(_cam->view_position, shift);
+    _cam->previous_position = cm_add(_cam->previous_position, shift);
+
+    _cam->origin[0] += _cells[0];
+    _cam->origin[1] += _cells[1];
+    _cam->origin[2] += _cells[2];
+    _cam->origin_generation++;
+}
+
+// Returns the number of cells a position relative to the origin is away from it, 0 within one cell
+static inline int32_t camera__origin_cells(float _position)
+{
+    if (_position <= CAMERA_ORIGIN_CELL_SIZE && _position >= -CAMERA_ORIGIN_CELL_SIZE)
+    {
+        return 0;
+    }
+    const float cells = _position / CAMERA_ORIGIN_CELL_SIZE;
+    return (int32_t)(cells < 0.0f ? cells - 0.5f : cells + 0.5f);
+}
+
+// Move the origin onto the cell of target_position once it left the origin cell
+static inline void camera__rebase(Camera* _cam)
+{
+    const int32_t cells[3] = {
+        camera__origin_cells(_cam->target_position.x),
+        camera__origin_cells(_cam->target_position.y),
+        camera__origin_cells(_cam->target_position.z),
+    };
+
+    if (cells[0] != 0 || cells[1] != 0 || cells[2] != 0)
+    {
+        camera__shift_origin(_cam, cells);
+    }
+}
+
+extern void camera_origin(const Camera* _cam, double* _out_origin)
+{
+    _out_origin[0] = (double)_cam->origin[0] * (double)CAMERA_ORIGIN_CELL_SIZE;
+    _out_origin[1] = (double)_cam->origin[1] * (double)CAMERA_ORIGIN_CELL_SIZE;
+    _out_origin[2] = (double)_cam->origin[2] * (double)CAMERA_ORIGIN_CELL_SIZE;
+}
+
+extern void camera_world_position(const Camera* _cam, double* _out_position)
+{
+    camera_origin(_cam, _out_position);
+    _out_position[0] += (double)_cam->target_position.x;
+    _out_position[1] += (double)_cam->target_position.y;
+    _out_position[2] += (double)_cam->target_position.z;
+}
+
+extern void camera_set_world_position(Camera* _cam, const double* _position)
+{
+    if (_cam->mode & CAMERA_MODE_FLOATING_ORIGIN)
+    {
+        // Round to the nearest cell, so the position relative to the origin stays within half a cell
+        int32_t cells[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            const double cell = _position[i] / (double)CAMERA_ORIGIN_CELL_SIZE;
+            cells[i] = (int32_t)(cell < 0.0 ? cell - 0.5 : cell + 0.5) - _cam->origin[i];
+        }
+
+        if (cells[0] != 0 || cells[1] != 0 || cells[2] != 0)
+        {
+            camera__shift_origin(_cam, cells);
+        }
+    }
+
+    double origin[3];
+    camera_origin(_cam, origin);
+    _cam->target_position = cm_init_vec3(
+        (float)(_position[0] - origin[0]),
+        (float)(_position[1] - origin[1]),
+        (float)(_position[2] - origin[2]));
+    camera_mark_dirty(_cam);
+}
+
+extern void camera_relative_position(const Camera* _cam, const double* _position, float* _out_position)
+{
+    double origin[3];
+    camera_origin(_cam, origin);
+    _out_position[0] = (float)(_position[0] - origin[0]);
+    _out_position[1] = (float)(_position[1] - origin[1]);
+    _out_position[2] = (float)(_position[2] - origin[2]);
+}
+
+extern void camera_move(Camera* _cam, const CameraVec3 _offset)
+{
+#if defined(CAMERA_CONCURRENT_INPUT)
+    camera__accumulate(&_cam->movement_accumulator.x, _offset.x);
+    camera__accumulate(&_cam->movement_accumulator.y, _offset.y);
+    camera__accumulate(&_cam->movement_accumulator.z, _offset.z);
+#else
+    _cam->movement_accumulator = cm_add(_cam->movement_accumulator, _offset);
+#endif
+    camera_mark_dirty(_cam);
+}
+
+extern void camera_rotate(Camera* _cam, const CameraVec3 _angles)
+{
+#if defined(CAMERA_CONCURRENT_INPUT)
+    camera__accumulate(&_cam->rotation_accumulator.x, _angles.x);
+    camera__accumulate(&_cam->rotation_accumulator.y, _angles.y);
+    camera__accumulate(&_cam->rotation_accumulator.z, _angles.z);
+#else
+    _cam->rotation_accumulator = cm_add(_cam->rotation_accumulator, _angles);
+#endif
+    camera_mark_dirty(_cam);
+}
+
+extern void camera_mark_dirty(Camera* _cam)
+{
+    camera__mark_dirty(&_cam->dirty, _cam->on_change, _cam->on_change_user);
+}
+
+extern void camera_set_position(Camera* _cam, CameraVec3 _position)
+{
+    _cam->target_position = _position;
+    camera_mark_dirty(_cam);
+}
+
+extern void camera_set_distance(Camera* _cam, float _distance)
+{
+    _cam->target_distance = _distance;
+    camera_mark_dirty(_cam);
+}
+
+extern void camera_set_orientation(Camera* _cam, CameraQuat _orientation)
+{
+    _cam->orientation = _orientation;
+    camera_mark_dirty(_cam);
+}
+
+extern void camera_set_mode(Camera* _cam, uint32_t _mode)
+{
+    _cam->mode = _mode;
+    camera_mark_dirty(_cam);
+}
+
+// Convert a forward and up direction to an orientation
+//  Based on the typical vector to matrix to quaternion approach.
+//  Instead of branching into one of four conversions, the largest of 4 * (w^2, x^2, y^2, z^2) is selected.
+//  All selects compile to conditional moves or blends, which makes the conversion branch-free.
+//  Ref.: https://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/
+static inline void camera__look_at(float _fx, float _fy, float _fz, float _ux, float _uy, float _uz,
+    float* _out_x, float* _out_y, float* _out_z, float* _out_w)
+{
+    // Get orthogonal basis vectors: right = normalize(up x forward), up = forward x right
+    float rx = _uy * _fz - _uz * _fy;
+    float ry = _uz * _fx - _ux * _fz;
+    float rz = _ux * _fy - _uy * _fx;
+    const float invLength = 1.0f / cm_sqrt(rx * rx + ry * ry + rz * rz);
+    rx *= invLength;
+    ry *= invLength;
+    rz *= invLength;
+
+    const float m0 = rx;
+    const float m1 = ry;
+    const float m2 = rz;
+
+    const float m4 = _fy * rz - _fz * ry;
+    const float m5 = _fz * rx - _fx * rz;
+    const float m6 = _fx * ry - _fy * rx;
+
+    const float m8 = _fx;
+    const float m9 = _fy;
+    const float m10 = _fz;
+
+    // 4 * w^2, 4 * x^2, 4 * y^2 and 4 * z^2
+    const float tw = 1.0f + m0 + m5 + m10;
+    const float tx = 1.0f + m0 - m5 - m10;
+    const float ty = 1.0f - m0 + m5 - m10;
+    const float tz = 1.0f - m0 - m5 + m10;
+
+    // Off-diagonal sums and differences, computed up front so that the selects below only pick existing values
+    const float sum01 = m4 + m1;
+    const float sum02 = m8 + m2;
+    const float sum12 = m9 + m6;
+    const float diff12 = m6 - m9;
+    const float diff20 = m8 - m2;
+    const float diff01 = m1 - m4;
+
+    // Each candidate is 4 * q * (the selected component), so it only has to be scaled by 1 / (2 * sqrt(t))
+    float t = tw;
+    float qx = diff12;
+    float qy = diff20;
+    float qz = diff01;
+    float qw = tw;
+
+    bool larger = tx > t;
+    t = larger ? tx : t;
+    qx = larger ? tx : qx;
+    qy = larger ? sum01 : qy;
+    qz = larger ? sum02 : qz;
+    qw = larger ? diff12 : qw;
+
+    larger = ty > t;
+    t = larger ? ty : t;
+    qx = larger ? sum01 : qx;
+    qy = larger ? ty : qy;
+    qz = larger ? sum12 : qz;
+    qw = larger ? diff20 : qw;
+
+    larger = tz > t;
+    t = larger ? tz : t;
+    qx = larger ? sum02 : qx;
+    qy = larger ? sum12 : qy;
+    qz = larger ? tz : qz;
+    qw = larger ? diff01 : qw;
+
+    const float scale = 0.5f / cm_sqrt(t);
+    *_out_x = qx * scale;
+    *_out_y = qy * scale;
+    *_out_z = qz * scale;
+    *_out_w = qw * scale;
+}
+
+extern void camera_look_at(Camera* _cam, CameraVec3 _forward, CameraVec3 _up)
+{
+    float x, y, z, w;
+    camera__look_at(_forward.x, _forward.y, _forward.z, _up.x, _up.y, _up.z, &x, &y, &z, &w);
+    _cam->orientation = cm_init_quat(x, y, z, w);
+    camera_mark_dirty(_cam);
+}
+
+extern void camera_look_at_position(Camera* _cam, CameraVec3 _target_point, CameraVec3 _up)
+{
+    float rotation[16];
+    cm_matrixFromQuat(rotation, _cam->orientation);
+    const CameraVec3 forward = cm_init_vec3(rotation[2], rotation[6], rotation[10]);
+    const CameraVec3 eye = cm_add(_cam->target_position, cm_scale(forward, -_cam->target_distance));
+
+    const CameraVec3 direction = cm_normalizeVec3(cm_add(_target_point, cm_negate(eye)));
+    camera_look_at(_cam, direction, _up);
+    _cam->target_position = cm_add(eye, cm_scale(direction, _cam->target_distance));
+}
+
+extern void camera_look_at_batch(const float* _forward_x, const float* _forward_y, const float* _forward_z,
+    const float* _up_x, const float* _up_y, const float* _up_z, uint32_t _count,
+    float* _out_x, float* _out_y, float* _out_z, float* _out_w)
+{
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+        float x, y, z, w;
+        camera__look_at(_forward_x[i], _forward_y[i], _forward_z[i], _up_x[i], _up_y[i], _up_z[i], &x, &y, &z, &w);
+        _out_x[i] = x;
+        _out_y[i] = y;
+        _out_z[i] = z;
+        _out_w[i] = w;
+    }
+}
+
+// Returns true if the camera struct was not manipulated since the last update
+static inline bool camera__is_unchanged(const Camera* _cam)
+{
+    return _cam->generation != 0 // Never updated (or wrapped around)
+        && _cam->target_position.x == _cam->applied_position.x
+        && _cam->target_position.y == _cam->applied_position.y
+        && _cam->target_position.z == _cam->applied_position.z
+        && _cam->target_distance == _cam->applied_distance
+        && _cam->orientation.x == _cam->applied_orientation.x
+        && _cam->orientation.y == _cam->applied_orientation.y
+        && _cam->orientation.z == _cam->applied_orientation.z
+        && _cam->orientation.w == _cam->applied_orientation.w
+        && _cam->mode == _cam->applied_mode
+        && _cam->minPitch == _cam->applied_limits[0] && _cam->maxPitch == _cam->applied_limits[1]
+        && _cam->minYaw == _cam->applied_limits[2] && _cam->maxYaw == _cam->applied_limits[3]
+        && _cam->minRoll == _cam->applied_limits[4] && _cam->maxRoll == _cam->applied_limits[5]
+        && _cam->boom_distance == _cam->applied_boom_distance;
+}
+
+// Write the view matrix of a basis and eye
+static CAMERA__FORCE_INLINE void camera__write_view(CameraVec3 _right, CameraVec3 _up, CameraVec3 _forward, CameraVec3 _eye, float* _out_matrix)
+{
+    _out_matrix[0] = _right.x;
+    _out_matrix[1] = _up.x;
+    _out_matrix[2] = _forward.x;
+    _out_matrix[3] = 0.0f;
+
+    _out_matrix[4] = _right.y;
+    _out_matrix[5] = _up.y;
+    _out_matrix[6] = _forward.y;
+    _out_matrix[7] = 0.0f;
+
+    _out_matrix[8] = _right.z;
+    _out_matrix[9] = _up.z;
+    _out_matrix[10] = _forward.z;
+    _out_matrix[11] = 0.0f;
+
+    // The rotation is orthonormal, so rotating -eye into view space is a dot product with each basis vector.
+    _out_matrix[12] = -cm_dot(_right, _eye);
+    _out_matrix[13] = -cm_dot(_up, _eye);
+    _out_matrix[14] = -cm_dot(_forward, _eye);
+    _out_matrix[15] = 1.0f;
+}
+
+// Store one row of 4 floats, streaming if requested and possible
+static CAMERA__FORCE_INLINE void camera__output_row(float* _out, float _a, float _b, float _c, float _d, bool _stream)
+{
+#if defined(CAMERA__STREAMING_STORES)
+    if (_stream && ((uintptr_t)_out & 15) == 0)
+    {
+        _mm_stream_ps(_out, _mm_setr_ps(_a, _b, _c, _d));
+        return;
+    }
+#else
+    (void)_stream;
+#endif
+    _out[0] = _a;
+    _out[1] = _b;
+    _out[2] = _c;
+    _out[3] = _d;
+}
+
+// Write the view matrix of a basis and eye for camera _index as described by _output
+//  Same matrix as camera__write_view(..), stored straight to the destination.
+static CAMERA__FORCE_INLINE void camera__output_view(const CameraOutput* _output, uint32_t _index,
+    CameraVec3 _right, CameraVec3 _up, CameraVec3 _forward, CameraVec3 _eye)
+{
+    float* out = (float*)((uint8_t*)_output->data + (size_t)_index * _output->stride);
+    const bool stream = (_output->flags & CAMERA_OUTPUT_STREAM) != 0;
+    const float tx = -cm_dot(_right, _eye);
+    const float ty = -cm_dot(_up, _eye);
+    const float tz = -cm_dot(_forward, _eye);
+
+    switch (_output->flags & (CAMERA_OUTPUT_COLUMN_MAJOR | CAMERA_OUTPUT_3X4))
+    {
+    case 0:
+        camera__output_row(out + 0, _right.x, _up.x, _forward.x, 0.0f, stream);
+        camera__output_row(out + 4, _right.y, _up.y, _forward.y, 0.0f, stream);
+        camera__output_row(out + 8, _right.z, _up.z, _forward.z, 0.0f, stream);
+        camera__output_row(out + 12, tx, ty, tz, 1.0f, stream);
+        break;
+    case CAMERA_OUTPUT_COLUMN_MAJOR:
+        camera__output_row(out + 0, _right.x, _right.y, _right.z, tx, stream);
+        camera__output_row(out + 4, _up.x, _up.y, _up.z, ty, stream);
+        camera__output_row(out + 8, _forward.x, _forward.y, _forward.z, tz, stream);
+        camera__output_row(out + 12, 0.0f, 0.0f, 0.0f, 1.0f, stream);
+        break;
+    case CAMERA_OUTPUT_COLUMN_MAJOR | CAMERA_OUTPUT_3X4:
+        camera__output_row(out + 0, _right.x, _right.y, _right.z, tx, stream);
+        camera__output_row(out + 4, _up.x, _up.y, _up.z, ty, stream);
+        camera__output_row(out + 8, _forward.x, _forward.y, _forward.z, tz, stream);
+        break;
+    default: // Row-major 3x4: four rows of three floats, too narrow for streaming
+        out[0] = _right.x;
+        out[1] = _up.x;
+        out[2] = _forward.x;
+        out[3] = _right.y;
+        out[4] = _up.y;
+        out[5] = _forward.y;
+        out[6] = _right.z;
+        out[7] = _up.z;
+        out[8] = _forward.z;
+        out[9] = tx;
+        out[10] = ty;
+        out[11] = tz;
+        break;
+    }
+}
+
+// Write the view matrix of the cached basis vectors and eye
+//  If _output is set, it is written for camera _index as described by _output instead of to _out_matrix.
+static CAMERA__FORCE_INLINE void camera__write_view_matrix(const Camera* _cam, float* _out_matrix, const CameraOutput* _output, uint32_t _index)
+{
+    if (_output != NULL)
+    {
+        camera__output_view(_output, _index, _cam->right, _cam->up, _cam->forward, _cam->eye);
+    }
+    else
+    {
+        camera__write_view(_cam->right, _cam->up, _cam->forward, _cam->eye, _out_matrix);
+    }
+}
+
+// Move the view state into the previous state
+//  Before the first update there is no previous state, so it is taken from the camera itself.
+static inline void camera__retain_previous(Camera* _cam)
+{
+    const bool updated = _cam->generation != 0;
+    _cam->previous_position = updated ? _cam->view_position : _cam->target_position;
+    _cam->previous_distance = updated ? _cam->view_distance : _cam->target_distance;
+    _cam->previous_orientation = updated ? _cam->view_orientation : _cam->orientation;
+}
+
+// Returns true if the view reached the camera state
+static inline bool camera__is_settled(const Camera* _cam)
+{
+    return _cam->view_position.x == _cam->target_position.x
+        && _cam->view_position.y == _cam->target_position.y
+        && _cam->view_position.z == _cam->target_position.z
+        && _cam->view_distance == _cam->target_distance
+        && _cam->view_orientation.x == _cam->orientation.x
+        && _cam->view_orientation.y == _cam->orientation.y
+        && _cam->view_orientation.z == _cam->orientation.z
+        && _cam->view_orientation.w == _cam->orientation.w;
+}
+
+// Returns true if an update with the pending _movement and _rotation takes the early-out
+static CAMERA__FORCE_INLINE bool camera__is_idle(const Camera* _cam, CameraVec3 _movement, CameraVec3 _rotation)
+{
+    return _movement.x == 0.0f && _movement.y == 0.0f && _movement.z == 0.0f
+        && _rotation.x == 0.0f && _rotation.y == 0.0f && _rotation.z == 0.0f
+        && camera__is_unchanged(_cam)
+        && camera__is_settled(_cam);
+}
+
+// Keep the dirty flag set after an update while the view is still on its way to the camera state (ex. smoothing)
+static inline void camera__retain_dirty(uint32_t* _dirty, bool _settled)
+{
+    if (!_settled)
+    {
+#if defined(CAMERA_CONCURRENT_INPUT)
+#if defined(_MSC_VER)
+        _InterlockedExchange((volatile long*)_dirty, 1);
+#else
+        __atomic_store_n(_dirty, 1u, __ATOMIC_RELEASE);
+#endif
+#else
+        *_dirty = 1;
+#endif
+    }
+}
+
+// Advance one spring component, _offset is the view value minus the camera value
+//  Returns false once offset and velocity are within CAMERA_SMOOTHING_EPSILON.
+static inline bool camera__spring(const float* _coefficients, float* _offset, float* _velocity)
+{
+    const float offset = *_offset;
+    const float velocity = *_velocity;
+    *_offset = _coefficients[0] * offset + _coefficients[1] * velocity;
+    *_velocity = _coefficients[2] * offset + _coefficients[3] * velocity;
+
+    return *_offset > CAMERA_SMOOTHING_EPSILON || *_offset < -CAMERA_SMOOTHING_EPSILON
+        || *_velocity > CAMERA_SMOOTHING_EPSILON || *_velocity < -CAMERA_SMOOTHING_EPSILON;
+}
+
+// Move the view state one time step of _smoothing towards the camera state
+//  Every spring snaps onto the camera state once all of its components are at rest.
+//  Returns true once all springs are at rest.
+static inline bool camera__smooth(Camera* _cam, const CameraSmoothing* _smoothing)
+{
+    const float* p = _smoothing->position;
+    CameraVec3 offset = cm_init_vec3(
+        _cam->view_position.x - _cam->target_position.x,
+        _cam->view_position.y - _cam->target_position.y,
+        _cam->view_position.z - _cam->target_position.z);
+    CameraVec3 velocity = _cam->position_velocity;
+    bool moving = camera__spring(p, &offset.x, &velocity.x);
+    moving |= camera__spring(p, &offset.y, &velocity.y);
+    moving |= camera__spring(p, &offset.z, &velocity.z);
+    _cam->view_position = moving ? cm_add(_cam->target_position, offset) : _cam->target_position;
+    _cam->position_velocity = moving ? velocity : cm_init_vec3(0.0f, 0.0f, 0.0f);
+    bool any_moving = moving;
+
+    float distance = _cam->view_distance - _cam->target_distance;
+    float distance_velocity = _cam->distance_velocity;
+    moving = camera__spring(_smoothing->distance, &distance, &distance_velocity);
+    _cam->view_distance = moving ? _cam->target_distance + distance : _cam->target_distance;
+    _cam->distance_velocity = moving ? distance_velocity : 0.0f;
+    any_moving |= moving;
+
+    // q and -q are the same orientation, so the spring pulls towards the one in the hemisphere of the view
+    //  Springing the components and normalizing the result is close to a spring on the rotation angle for small offsets.
+    const CameraQuat view = _cam->view_orientation;
+    const float cosine = view.x * _cam->orientation.x + view.y * _cam->orientation.y
+        + view.z * _cam->orientation.z + view.w * _cam->orientation.w;
+    const float sign = cosine < 0.0f ? -1.0f : 1.0f;
+    const float* o = _smoothing->orientation;
+    float qx = view.x - sign * _cam->orientation.x;
+    float qy = view.y - sign * _cam->orientation.y;
+    float qz = view.z - sign * _cam->orientation.z;
+    float qw = view.w - sign * _cam->orientation.w;
+    CameraQuat spin = _cam->orientation_velocity;
+    moving = camera__spring(o, &qx, &spin.x);
+    moving |= camera__spring(o, &qy, &spin.y);
+    moving |= camera__spring(o, &qz, &spin.z);
+    moving |= camera__spring(o, &qw, &spin.w);
+    _cam->view_orientation = moving
+        ? cm_normalizeQuat(cm_init_quat(
+            sign * _cam->orientation.x + qx,
+            sign * _cam->orientation.y + qy,
+            sign * _cam->orientation.z + qz,
+            sign * _cam->orientation.w + qw))
+        : _cam->orientation;
+    _cam->orientation_velocity = moving ? spin : cm_init_quat(0.0f, 0.0f, 0.0f, 0.0f);
+    return !(any_moving | moving);
+}
+
+// Returns the world space (pitch, yaw, roll) of an orientation
+//  This is the inverse of composing yaw * pitch * roll, the order used by the camera (see "Update orientation").
+static inline CameraVec3 camera__euler(CameraQuat _q)
+{
+    const float sinPitch = 2.0f * (_q.x * _q.w - _q.y * _q.z);
+
+    CAMERA__PROFILE_COUNT(asin, 1);
+    CAMERA__PROFILE_COUNT(atan2, 2);
+
+    return cm_init_vec3(
+        cm_asin(cm_min(cm_max(sinPitch, -1.0f), 1.0f)),
+        cm_atan2(2.0f * (_q.x * _q.z + _q.y * _q.w), 1.0f - 2.0f * (_q.x * _q.x + _q.y * _q.y)),
+        cm_atan2(2.0f * (_q.x * _q.y + _q.z * _q.w), 1.0f - 2.0f * (_q.x * _q.x + _q.z * _q.z))
+    );
+}
+
+// Re-normalize an orientation only once it drifted more than CAMERA_NORMALIZE_EPSILON
+//  Close to unit length the first order correction q * (1.5 - 0.5 * |q|^2) squares the error,
+//  anything further off (ex. a directly written orientation) gets a full normalization.
+static inline CameraQuat camera__renormalize(CameraQuat _q)
+{
+    const float norm2 = _q.x * _q.x + _q.y * _q.y + _q.z * _q.z + _q.w * _q.w;
+    const float error = norm2 - 1.0f;
+
+    if (error <= CAMERA_NORMALIZE_EPSILON && error >= -CAMERA_NORMALIZE_EPSILON)
+    {
+        return _q;
+    }
+
+    CAMERA__PROFILE_COUNT(renormalizations, 1);
+
+    if (error > 0.01f || error < -0.01f)
+    {
+        return cm_normalizeQuat(_q);
+    }
+
+    const float scale = 1.5f - 0.5f * norm2;
+    return cm_init_quat(_q.x * scale, _q.y * scale, _q.z * scale, _q.w * scale);
+}
+
+// Wrap an angle into [-pi; pi]
+static inline float camera__wrap_angle(float _angle)
+{
+    const float pi = 3.14159265358979f;
+
+    if (_angle > pi)
+    {
+        _angle -= 2.0f * pi;
+    }
+    else if (_angle < -pi)
+    {
+        _angle += 2.0f * pi;
+    }
+    return _angle;
+}
+
+// Shared update kernel of camera_view_matrix(..) and camera_view_matrix_batch(..)
+//  _movement and _rotation are the pending input, already taken out of the accumulators.
+//  All mode branches test _mode instead of _cam->mode. Passing a constant removes the branches after inlining.
+//  The view matrix is written to _out_matrix, or if _output is set, straight to camera _index of _output.
+//  Returns true if the view reached the camera state, false while it is still smoothed towards it.
+static CAMERA__FORCE_INLINE bool camera__update(Camera* _cam, uint32_t _mode, CameraVec3 _movement, CameraVec3 _rotation,
+    float* _out_matrix, const CameraOutput* _output, uint32_t _index)
+{
+    CAMERA__PROFILE_COUNT(updates, 1);
+
+    // Nothing to do, re-emit the previous view matrix
+    if (camera__is_idle(_cam, _movement, _rotation))
+    {
+        CAMERA__PROFILE_COUNT(early_outs, 1);
+        camera__retain_previous(_cam);
+        CAMERA__PROFILE_BEGIN(CAMERA_PROFILE_PHASE_MATRIX, camera_matrix);
+        camera__write_view_matrix(_cam, _out_matrix, _output, _index);
+        CAMERA__PROFILE_END(camera_matrix);
+        return true;
+    }
+
+
+    /* Clamp angles */
+
+    const bool clamping = (_mode & (CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE)) != 0;
+
+    if (clamping)
+    {
+        CAMERA__PROFILE_BEGIN(CAMERA_PROFILE_PHASE_CLAMP, camera_clamp);
+
+        // Without roll, pitch and yaw compose additively (see "Update orientation"),
+        //  so the tracked angles stay valid as long as nobody touched the orientation or mode.
+        const bool tracked = (_mode & CAMERA_MODE_DISABLE_ROLL)
+            && _cam->generation != 0
+            && _cam->mode == _cam->applied_mode
+            && _cam->orientation.x == _cam->applied_orientation.x
+            && _cam->orientation.y == _cam->applied_orientation.y
+            && _cam->orientation.z == _cam->applied_orientation.z
+            && _cam->orientation.w == _cam->applied_orientation.w;
+
+        if (!tracked)
+        {
+            // Note: The orientation may have been set to anything, the angles are only meaningful for a unit quaternion
+            _cam->orientation = cm_normalizeQuat(_cam->orientation);
+            _cam->angles = camera__euler(_cam->orientation);
+        }
+
+        const CameraVec3 angles = _cam->angles;
+
+        if (_mode & CAMERA_MODE_CLAMP_PITCH_ANGLE)
+        {
+            _rotation.x = cm_max(_cam->minPitch - angles.x, _rotation.x);
+            _rotation.x = cm_min(_cam->maxPitch - angles.x, _rotation.x);
+        }
+
+        if (_mode & CAMERA_MODE_CLAMP_YAW_ANGLE)
+        {
+            _rotation.y = cm_max(_cam->minYaw - angles.y, _rotation.y);
+            _rotation.y = cm_min(_cam->maxYaw - angles.y, _rotation.y);
+        }
+
+        if (_mode & CAMERA_MODE_CLAMP_ROLL_ANGLE)
+        {
+            _rotation.z = cm_max(_cam->minRoll - angles.z, _rotation.z);
+            _rotation.z = cm_min(_cam->maxRoll - angles.z, _rotation.z);
+        }
+
+        CAMERA__PROFILE_END(camera_clamp);
+    }
+
+
+    /* Update orientation */
+
+    CAMERA__PROFILE_BEGIN(CAMERA_PROFILE_PHASE_ORIENTATION, camera_orientation);
+
+    // Half angle sine and cosine of each axis rotation. Axes without rotation skip the sincos.
+    //  The world axes are expected to be aligned with x, y and z, their sign is folded into the sine.
+    float sp = 0.0f, cp = 1.0f;
+    float sy = 0.0f, cy = 1.0f;
+    float sr = 0.0f, cr = 1.0f;
+
+    if (_rotation.x != 0.0f)
+    {
+        cm_sincos(_rotation.x * 0.5f, &sp, &cp);
+        CAMERA__PROFILE_COUNT(sincos, 1);
+        sp *= CAMERA_WORLD_RIGHT.x;
+    }
+
+    if (_rotation.y != 0.0f)
+    {
+        cm_sincos(_rotation.y * 0.5f, &sy, &cy);
+        CAMERA__PROFILE_COUNT(sincos, 1);
+        sy *= CAMERA_WORLD_UP.y;
+    }
+
+    const CameraQuat q = _cam->orientation;
+
+    if (_mode & CAMERA_MODE_DISABLE_ROLL)
+    {
+        // orientation = yaw * orientation * pitch
+        //  with pitch = (sp, 0, 0, cp) and yaw = (0, sy, 0, cy)
+        // Note: The multiplication order is important, not to induce roll from pitch+yaw
+        const float px = q.w * sp + q.x * cp;
+        const float py = q.y * cp + q.z * sp;
+        const float pz = q.z * cp - q.y * sp;
+        const float pw = q.w * cp - q.x * sp;
+
+        _cam->orientation = cm_init_quat(
+            cy * px + sy * pz,
+            cy * py + sy * pw,
+            cy * pz - sy * px,
+            cy * pw - sy * py
+        );
+
+        if (clamping)
+        {
+            _cam->angles.x = camera__wrap_angle(_cam->angles.x + _rotation.x);
+            _cam->angles.y = camera__wrap_angle(_cam->angles.y + _rotation.y);
+        }
+    }
+    else
+    {
+        if (_rotation.z != 0.0f)
+        {
+            cm_sincos(_rotation.z * 0.5f, &sr, &cr);
+            CAMERA__PROFILE_COUNT(sincos, 1);
+            sr *= CAMERA_WORLD_FORWARD.z;
+        }
+
+        // orientation = orientation * (pitch * yaw * roll)
+        //  with pitch = (sp, 0, 0, cp), yaw = (0, sy, 0, cy) and roll = (0, 0, sr, cr)
+        const float ax = sp * cy;
+        const float ay = cp * sy;
+        const float az = sp * sy;
+        const float aw = cp * cy;
+
+        const CameraQuat rotation = cm_init_quat(
+            ax * cr + ay * sr,
+            ay * cr - ax * sr,
+            aw * sr + az * cr,
+            aw * cr - az * sr
+        );
+
+        _cam->orientation = cm_mulQuat(q, rotation);
+    }
+
+    _cam->orientation = camera__renormalize(_cam->orientation);
+
+
+    /* Update basis vectors */
+
+    // Get rotation matrix
+    //  Its columns are the camera basis vectors in world space.
+    float rotation[16];
+    cm_matrixFromQuat(rotation, _cam->orientation);
+
+    _cam->right = cm_init_vec3(rotation[0], rotation[4], rotation[8]);
+    _cam->up = cm_init_vec3(rotation[1], rotation[5], rotation[9]);
+    _cam->forward = cm_init_vec3(rotation[2], rotation[6], rotation[10]);
+
+    CAMERA__PROFILE_END(camera_orientation);
+
+
+    /* Update target_position */
+
+    CAMERA__PROFILE_BEGIN(CAMERA_PROFILE_PHASE_POSITION, camera_position);
+
+    CameraVec3 forward = _cam->forward;
+    CameraVec3 up = _cam->up;
+    CameraVec3 right = _cam->right;
+
+    if (_mode & CAMERA_MODE_MOVE_IN_WORLDPLANE)
+    {
+        const float epsilon = 0.0001f; // Avoid floating point errors
+
+        if (forward.y > 1.0f - epsilon) // Note: forward is normalized, so checking .y is sufficent
+        { // Special case: Looking straight up
+            forward = cm_negate(up);
+        }
+        else if (forward.y < -1.0f + epsilon)
+        { // Special case: Looking straight down
+            forward = up;
+        }
+        else if (right.y > 1.0f - epsilon)
+        {
+            right = up;
+        }
+        else if (right.y < -1.0f + epsilon)
+        {
+            right = cm_negate(up);
+        }
+
+        // Project the forward and right into the world plane
+        forward.y = 0;
+        forward = cm_normalizeVec3(forward);
+
+        right.y = 0;
+        right = cm_normalizeVec3(right);
+
+        up = CAMERA_WORLD_UP;
+    }
+
+    // Scale by desired distance
+    forward = cm_scale(forward, _movement.x);
+    up = cm_scale(up, _movement.y);
+    right = cm_scale(right, _movement.z);
+
+    // Apply changes to target_position
+    _cam->target_position = cm_add(_cam->target_position, forward);
+    _cam->target_position = cm_add(_cam->target_position, up);
+    _cam->target_position = cm_add(_cam->target_position, right);
+
+
+    /* Rebase origin */
+
+    if (_mode & CAMERA_MODE_FLOATING_ORIGIN)
+    {
+        camera__rebase(_cam);
+    }
+
+
+    /* Update view state */
+
+    camera__retain_previous(_cam);
+
+    bool settled = true;
+    if (_cam->smoothing != NULL && _cam->generation != 0)
+    {
+        settled = camera__smooth(_cam, _cam->smoothing);
+
+        // The view basis follows the smoothed orientation, movement above used the unsmoothed one
+        cm_matrixFromQuat(rotation, _cam->view_orientation);
+
+        _cam->right = cm_init_vec3(rotation[0], rotation[4], rotation[8]);
+        _cam->up = cm_init_vec3(rotation[1], rotation[5], rotation[9]);
+        _cam->forward = cm_init_vec3(rotation[2], rotation[6], rotation[10]);
+    }
+    else
+    {
+        _cam->view_position = _cam->target_position;
+        _cam->view_distance = _cam->target_distance;
+        _cam->view_orientation = _cam->orientation;
+        _cam->position_velocity = cm_init_vec3(0.0f, 0.0f, 0.0f);
+        _cam->distance_velocity = 0.0f;
+        _cam->orientation_velocity = cm_init_quat(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+
+    /* Update eye */
+
+    _cam->eye = cm_add(_cam->view_position, cm_scale(_cam->forward, -cm_min(_cam->view_distance, _cam->boom_distance)));
+
+    CAMERA__PROFILE_END(camera_position);
+
+
+    /* Remember applied state */
+
+    _cam->applied_position = _cam->target_position;
+    _cam->applied_distance = _cam->target_distance;
+    _cam->applied_orientation = _cam->orientation;
+    _cam->applied_mode = _cam->mode;
+    _cam->applied_limits[0] = _cam->minPitch;
+    _cam->applied_limits[1] = _cam->maxPitch;
+    _cam->applied_limits[2] = _cam->minYaw;
+    _cam->applied_limits[3] = _cam->maxYaw;
+    _cam->applied_limits[4] = _cam->minRoll;
+    _cam->applied_limits[5] = _cam->maxRoll;
+    _cam->applied_boom_distance = _cam->boom_distance;
+
+    _cam->generation++;
+
+
+    /* Generate view matrix */
+
+    CAMERA__PROFILE_BEGIN(CAMERA_PROFILE_PHASE_MATRIX, camera_matrix);
+    camera__write_view_matrix(_cam, _out_matrix, _output, _index);
+    CAMERA__PROFILE_END(camera_matrix);
+    return settled;
+}
+
+extern void camera_view_matrix(Camera* _cam, float* _out_matrix)
+{
+    camera__clear_dirty(&_cam->dirty);
+    const CameraVec3 movement = camera__drain(&_cam->movement_accumulator);
+    const CameraVec3 rotation = camera__drain(&_cam->rotation_accumulator);
+    const bool settled = camera__update(_cam, _cam->mode, movement, rotation, _out_matrix, NULL, 0);
+    camera__retain_dirty(&_cam->dirty, settled);
+}
+
+extern CameraOutput camera_output(void* _data, uint32_t _stride, uint32_t _flags)
+{
+    CameraOutput output;
+    output.data = _data;
+    output.stride = _stride;
+    output.flags = _flags;
+    return output;
+}
+
+// Make streamed stores visible before the destination is handed on (ex. to the GPU or another thread)
+static inline void camera__output_fence(const CameraOutput* _output)
+{
+#if defined(CAMERA__STREAMING_STORES)
+    if (_output->flags & CAMERA_OUTPUT_STREAM)
+    {
+        _mm_sfence();
+    }
+#else
+    (void)_output;
+#endif
+}
+
+extern void camera_view_matrix_output(Camera* _cam, const CameraOutput* _output)
+{
+    camera__clear_dirty(&_cam->dirty);
+    const CameraVec3 movement = camera__drain(&_cam->movement_accumulator);
+    const CameraVec3 rotation = camera__drain(&_cam->rotation_accumulator);
+
+    const bool settled = camera__update(_cam, _cam->mode, movement, rotation, NULL, _output, 0);
+    camera__retain_dirty(&_cam->dirty, settled);
+    camera__output_fence(_output);
+}
+
+// Write the coefficients of one critically damped spring with angular frequency 2 / _time over _dt
+//  offset(dt) = (offset + (velocity + w * offset) * dt) * e^(-w * dt), velocity(dt) is its derivative.
+static inline void camera__spring_coefficients(float _time, float _dt, float* _out_coefficients)
+{
+    if (_time <= 0.0f)
+    {
+        _out_coefficients[0] = 0.0f;
+        _out_coefficients[1] = 0.0f;
+        _out_coefficients[2] = 0.0f;
+        _out_coefficients[3] = 0.0f;
+        return;
+    }
+
+    const float omega = 2.0f / _time;
+    const float x = omega * _dt;
+    const float decay = cm_exp(-x);
+
+    _out_coefficients[0] = decay * (1.0f + x);
+    _out_coefficients[1] = decay * _dt;
+    _out_coefficients[2] = -decay * omega * x;
+    _out_coefficients[3] = decay * (1.0f - x);
+}
+
+extern CameraSmoothing camera_smoothing(float _position_time, float _distance_time, float _orientation_time, float _dt)
+{
+    CameraSmoothing smoothing;
+    camera__spring_coefficients(_position_time, _dt, smoothing.position);
+    camera__spring_coefficients(_distance_time, _dt, smoothing.distance);
+    camera__spring_coefficients(_orientation_time, _dt, smoothing.orientation);
+    return smoothing;
+}
+
+extern CameraBoom camera_boom(float _radius, float _min_distance, float _in_time, float _out_time, float _dt)
+{
+    CameraBoom boom;
+    boom.radius = _radius;
+    boom.min_distance = _min_distance;
+    boom.in_blend = _in_time > 0.0f ? 1.0f - cm_exp(-_dt / _in_time) : 1.0f;
+    boom.out_blend = _out_time > 0.0f ? 1.0f - cm_exp(-_dt / _out_time) : 1.0f;
+    return boom;
+}
+
+static inline CameraBoomRay camera__boom_ray(CameraVec3 _position, float _distance, CameraVec3 _forward, const CameraBoom* _boom)
+{
+    CameraBoomRay ray;
+    ray.origin = _position;
+    ray.direction = cm_negate(_forward);
+    ray.length = cm_max(_distance, 0.0f) + _boom->radius;
+    return ray;
+}
+
+// Returns the boom distance one step closer to the hit distance
+static inline float camera__boom(float _boom_distance, float _view_distance, float _hit_distance, const CameraBoom* _boom)
+{
+    const float target = cm_max(_hit_distance - _boom->radius, _boom->min_distance);
+
+    // A boom that is off (or further out than the eye) starts at the eye
+    const float current = cm_min(_boom_distance, cm_max(_view_distance, target));
+    const float blend = target < current ? _boom->in_blend : _boom->out_blend;
+    float distance = current + (target - current) * blend;
+
+    // Snap onto the target, so an idle camera takes the early-out again
+    distance = (distance - target < CAMERA_SMOOTHING_EPSILON && target - distance < CAMERA_SMOOTHING_EPSILON) ? target : distance;
+    return distance >= _view_distance ? CAMERA_BOOM_OFF : distance;
+}
+
+extern CameraBoomRay camera_boom_ray(const Camera* _cam, const CameraBoom* _boom)
+{
+    return camera__boom_ray(_cam->view_position, _cam->view_distance, _cam->forward, _boom);
+}
+
+extern void camera_boom_apply(Camera* _cam, const CameraBoom* _boom, float _hit_distance)
+{
+    const float distance = camera__boom(_cam->boom_distance, _cam->view_distance, _hit_distance, _boom);
+    if (distance != _cam->boom_distance)
+    {
+        _cam->boom_distance = distance;
+        camera_mark_dirty(_cam);
+    }
+}
+
+extern void camera_boom_request_batch(const CameraPool* _pool, const CameraBoom* _boom, CameraBoomRay* _out_rays, float* _out_hit_distances,
+    CameraBoomQueryFn _query, void* _user)
+{
+    for (uint32_t i = 0; i < _pool->count; ++i)
+    {
+        _out_rays[i] = camera__boom_ray(
+            cm_init_vec3(_pool->view_position_x[i], _pool->view_position_y[i], _pool->view_position_z[i]),
+            _pool->view_distance[i],
+            cm_init_vec3(_pool->forward_x[i], _pool->forward_y[i], _pool->forward_z[i]),
+            _boom);
+    }
+    _query(_user, _out_rays, _pool->count, _out_hit_distances);
+}
+
+extern void camera_boom_apply_batch(CameraPool* _pool, const CameraBoom* _boom, const float* _hit_distances)
+{
+    for (uint32_t i = 0; i < _pool->count; ++i)
+    {
+        const float distance = camera__boom(_pool->boom_distance[i], _pool->view_distance[i], _hit_distances[i], _boom);
+        if (distance != _pool->boom_distance[i])
+        {
+            _pool->boom_distance[i] = distance;
+            camera_pool_mark_dirty(_pool, i);
+        }
+    }
+}
+
+// Shared blend of camera_view_matrix_interpolated(..) and camera_view_matrix_interpolated_batch(..)
+//  Both states are at most one simulation step apart, so the normalized lerp of the orientations
+//  stays close to the slerp and needs no trigonometry.
+static inline void camera__interpolate(CameraVec3 _previous_position, float _previous_distance, CameraQuat _previous_orientation,
+    CameraVec3 _position, float _distance, CameraQuat _orientation, float _boom_distance, float _alpha, float* _out_matrix)
+{
+    // q and -q are the same orientation, blend towards the one in the hemisphere of the previous state
+    const float cosine = _previous_orientation.x * _orientation.x + _previous_orientation.y * _orientation.y
+        + _previous_orientation.z * _orientation.z + _previous_orientation.w * _orientation.w;
+    const float beta = cosine < 0.0f ? -_alpha : _alpha;
+    const float keep = 1.0f - _alpha;
+
+    const CameraQuat orientation = cm_normalizeQuat(cm_init_quat(
+        _previous_orientation.x * keep + _orientation.x * beta,
+        _previous_orientation.y * keep + _orientation.y * beta,
+        _previous_orientation.z * keep + _orientation.z * beta,
+        _previous_orientation.w * keep + _orientation.w * beta
+    ));
+
+    float rotation[16];
+    cm_matrixFromQuat(rotation, orientation);
+    const CameraVec3 right = cm_init_vec3(rotation[0], rotation[4], rotation[8]);
+    const CameraVec3 up = cm_init_vec3(rotation[1], rotation[5], rotation[9]);
+    const CameraVec3 forward = cm_init_vec3(rotation[2], rotation[6], rotation[10]);
+
+    const CameraVec3 position = cm_add(cm_scale(_previous_position, keep), cm_scale(_position, _alpha));
+    const float distance = cm_min(_previous_distance * keep + _distance * _alpha, _boom_distance);
+    const CameraVec3 eye = cm_add(position, cm_scale(forward, -distance));
+
+    camera__write_view(right, up, forward, eye, _out_matrix);
+}
+
+extern void camera_view_matrix_interpolated(const Camera* _cam, float _alpha, float* _out_matrix)
+{
+    camera__interpolate(_cam->previous_position, _cam->previous_distance, _cam->previous_orientation,
+        _cam->view_position, _cam->view_distance, _cam->view_orientation, _cam->boom_distance, _alpha, _out_matrix);
+}
+
+extern size_t camera_pool_memory_size(uint32_t _capacity)
+{
+    const size_t capacity = (_capacity + CAMERA_POOL_LANES - 1) / CAMERA_POOL_LANES * CAMERA_POOL_LANES;
+    size_t size = 0;
+
+#define CAMERA_POOL_ARRAY_SIZE(_type, _array, _member) size += capacity * sizeof(_type) + CAMERA_POOL_ALIGNMENT;
+    CAMERA_POOL_FIELDS(CAMERA_POOL_ARRAY_SIZE)
+#undef CAMERA_POOL_ARRAY_SIZE
+
+    return size;
+}
+
+extern CameraPool camera_pool_init(void* _memory, uint32_t _capacity)
+{
+    CameraPool pool;
+    pool.count = 0;
+    pool.capacity = (_capacity + CAMERA_POOL_LANES - 1) / CAMERA_POOL_LANES * CAMERA_POOL_LANES;
+
+    // Every array size is a multiple of CAMERA_POOL_ALIGNMENT, so all arrays stay aligned
+    //  Each array is followed by one cache line of padding. Otherwise power-of-two capacities place
+    //  camera i of every array in the same cache set, and loading one camera evicts the previous one.
+    uint8_t* memory = (uint8_t*)_memory;
+
+#define CAMERA_POOL_ASSIGN_ARRAY(_type, _array, _member) \
+    pool._array = (_type*)memory; \
+    memory += pool.capacity * sizeof(_type) + CAMERA_POOL_ALIGNMENT;
+    CAMERA_POOL_FIELDS(CAMERA_POOL_ASSIGN_ARRAY)
+#undef CAMERA_POOL_ASSIGN_ARRAY
+
+    return pool;
+}
+
+#define CAMERA_POOL_LOAD(_type, _array, _member) _cam->_member = _pool->_array[_index];
+#define CAMERA_POOL_STORE(_type, _array, _member) _pool->_array[_index] = _cam->_member;
+
+// Copy camera _index out of the pool arrays
+static inline void camera__pool_load(const CameraPool* _pool, uint32_t _index, Camera* _cam)
+{
+    CAMERA_POOL_FIELDS(CAMERA_POOL_LOAD)
+}
+
+// Copy _cam into the pool arrays at _index
+static inline void camera__pool_store(CameraPool* _pool, uint32_t _index, const Camera* _cam)
+{
+    CAMERA_POOL_FIELDS(CAMERA_POOL_STORE)
+}
+
+// Copy the members the update of camera _index reads out of the pool arrays
+//  _mode is the mode the camera is updated as, the members it does not use are skipped.
+static CAMERA__FORCE_INLINE void camera__pool_load_state(const CameraPool* _pool, uint32_t _index, uint32_t _mode, Camera* _cam)
+{
+    CAMERA_POOL_SETTINGS_FIELDS(CAMERA_POOL_LOAD)
+    CAMERA_POOL_UPDATED_FIELDS(CAMERA_POOL_LOAD)
+    CAMERA_POOL_BASIS_FIELDS(CAMERA_POOL_LOAD)
+
+    if (_cam->smoothing != NULL)
+    {
+        CAMERA_POOL_VELOCITY_FIELDS(CAMERA_POOL_LOAD)
+    }
+    if (_mode & (CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE))
+    {
+        CAMERA_POOL_ANGLE_FIELDS(CAMERA_POOL_LOAD)
+    }
+    if (_mode & CAMERA_MODE_FLOATING_ORIGIN)
+    {
+        CAMERA_POOL_ORIGIN_FIELDS(CAMERA_POOL_LOAD)
+    }
+}
+
+// Copy the members the update of camera _index wrote back into the pool arrays
+static CAMERA__FORCE_INLINE void camera__pool_store_state(CameraPool* _pool, uint32_t _index, uint32_t _mode, const Camera* _cam)
+{
+    CAMERA_POOL_PREVIOUS_FIELDS(CAMERA_POOL_STORE)
+    CAMERA_POOL_UPDATED_FIELDS(CAMERA_POOL_STORE)
+    CAMERA_POOL_VELOCITY_FIELDS(CAMERA_POOL_STORE)
+    CAMERA_POOL_BASIS_FIELDS(CAMERA_POOL_STORE)
+
+    if (_mode & (CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE))
+    {
+        CAMERA_POOL_ANGLE_FIELDS(CAMERA_POOL_STORE)
+    }
+    if (_mode & CAMERA_MODE_FLOATING_ORIGIN)
+    {
+        CAMERA_POOL_ORIGIN_FIELDS(CAMERA_POOL_STORE)
+    }
+}
+
+#undef CAMERA_POOL_LOAD
+#undef CAMERA_POOL_STORE
+
+extern uint32_t camera_pool_add(CameraPool* _pool, const Camera* _cam)
+{
+    if (_pool->count >= _pool->capacity)
+    {
+        return UINT32_MAX;
+    }
+
+    const uint32_t index = _pool->count++;
+    camera__pool_store(_pool, index, _cam);
+    return index;
+}
+
+extern void camera_pool_remove(CameraPool* _pool, uint32_t _index)
+{
+    const uint32_t last = --_pool->count;
+    if (_index != last)
+    {
+#define CAMERA_POOL_MOVE(_type, _array, _member) _pool->_array[_index] = _pool->_array[last];
+        CAMERA_POOL_FIELDS(CAMERA_POOL_MOVE)
+#undef CAMERA_POOL_MOVE
+    }
+}
+
+extern Camera camera_pool_get(const CameraPool* _pool, uint32_t _index)
+{
+    Camera cam = camera_init();
+    camera__pool_load(_pool, _index, &cam);
+    return cam;
+}
+
+extern void camera_pool_set(CameraPool* _pool, uint32_t _index, const Camera* _cam)
+{
+    camera__pool_store(_pool, _index, _cam);
+}
+
+extern void camera_pool_move(CameraPool* _pool, uint32_t _index, const CameraVec3 _offset)
+{
+    camera__accumulate(&_pool->movement_accumulator_x[_index], _offset.x);
+    camera__accumulate(&_pool->movement_accumulator_y[_index], _offset.y);
+    camera__accumulate(&_pool->movement_accumulator_z[_index], _offset.z);
+    camera_pool_mark_dirty(_pool, _index);
+}
+
+extern void camera_pool_rotate(CameraPool* _pool, uint32_t _index, const CameraVec3 _angles)
+{
+    camera__accumulate(&_pool->rotation_accumulator_x[_index], _angles.x);
+    camera__accumulate(&_pool->rotation_accumulator_y[_index], _angles.y);
+    camera__accumulate(&_pool->rotation_accumulator_z[_index], _angles.z);
+    camera_pool_mark_dirty(_pool, _index);
+}
+
+extern void camera_pool_mark_dirty(CameraPool* _pool, uint32_t _index)
+{
+    camera__mark_dirty(&_pool->dirty[_index], _pool->on_change[_index], _pool->on_change_user[_index]);
+}
+
+extern size_t camera_registry_memory_size(uint32_t _capacity)
+{
+    const size_t capacity = (_capacity + CAMERA_POOL_LANES - 1) / CAMERA_POOL_LANES * CAMERA_POOL_LANES;
+    return camera_pool_memory_size(_capacity) + 4 * capacity * sizeof(uint32_t);
+}
+
+extern CameraRegistry camera_registry_init(void* _memory, uint32_t _capacity)
+{
+    CameraRegistry registry;
+    registry.pool = camera_pool_init(_memory, _capacity);
+
+    // The pool size is a multiple of CAMERA_POOL_ALIGNMENT, the slot arrays follow it
+    const uint32_t capacity = registry.pool.capacity;
+    registry.slot_generation = (uint32_t*)((uint8_t*)_memory + camera_pool_memory_size(_capacity));
+    registry.slot_index = registry.slot_generation + capacity;
+    registry.pool_slot = registry.slot_index + capacity;
+    registry.scratch = registry.pool_slot + capacity;
+
+    // All slots free, chained in ascending order
+    for (uint32_t i = 0; i < capacity; ++i)
+    {
+        registry.slot_generation[i] = 0;
+        registry.slot_index[i] = i + 1 < capacity ? i + 1 : UINT32_MAX;
+    }
+    registry.free_slot = capacity > 0 ? 0 : UINT32_MAX;
+    registry.group_count = 0;
+
+    return registry;
+}
+
+extern CameraHandle camera_registry_create(CameraRegistry* _registry, const Camera* _cam)
+{
+    CameraHandle handle;
+    handle.slot = 0;
+    handle.generation = 0;
+
+    const uint32_t slot = _registry->free_slot;
+    const uint32_t index = camera_pool_add(&_registry->pool, _cam);
+    if (index == UINT32_MAX)
+    {
+        return handle;
+    }
+
+    _registry->free_slot = _registry->slot_index[slot];
+    _registry->slot_generation[slot]++;
+    _registry->slot_index[slot] = index;
+    _registry->pool_slot[index] = slot;
+    _registry->group_count = 0;
+
+    handle.slot = slot;
+    handle.generation = _registry->slot_generation[slot];
+    return handle;
+}
+
+extern void camera_registry_destroy(CameraRegistry* _registry, CameraHandle _handle)
+{
+    if (!camera_registry_valid(_registry, _handle))
+    {
+        return;
+    }
+
+    // The last camera moves into the freed index
+    const uint32_t index = _registry->slot_index[_handle.slot];
+    const uint32_t last = _registry->pool.count - 1;
+    camera_pool_remove(&_registry->pool, index);
+    _registry->pool_slot[index] = _registry->pool_slot[last];
+    _registry->slot_index[_registry->pool_slot[index]] = index;
+
+    _registry->slot_generation[_handle.slot]++;
+    _registry->slot_index[_handle.slot] = _registry->free_slot;
+    _registry->free_slot = _handle.slot;
+    _registry->group_count = 0;
+}
+
+extern bool camera_registry_valid(const CameraRegistry* _registry, CameraHandle _handle)
+{
+    return _handle.slot < _registry->pool.capacity
+        && (_handle.generation & 1) != 0
+        && _registry->slot_generation[_handle.slot] == _handle.generation;
+}
+
+extern uint32_t camera_registry_index(const CameraRegistry* _registry, CameraHandle _handle)
+{
+    return camera_registry_valid(_registry, _handle) ? _registry->slot_index[_handle.slot] : UINT32_MAX;
+}
+
+extern CameraHandle camera_registry_handle(const CameraRegistry* _registry, uint32_t _index)
+{
+    CameraHandle handle;
+    handle.slot = _registry->pool_slot[_index];
+    handle.generation = _registry->slot_generation[handle.slot];
+    return handle;
+}
+
+// Exchange the cameras at pool indices _a and _b, including their pending input
+static inline void camera__registry_swap(CameraRegistry* _registry, uint32_t _a, uint32_t _b)
+{
+    CameraPool* pool = &_registry->pool;
+#define CAMERA_POOL_SWAP(_type, _array, _member) \
+    { \
+        _type value = pool->_array[_a]; \
+        pool->_array[_a] = pool->_array[_b]; \
+        pool->_array[_b] = value; \
+    }
+    CAMERA_POOL_FIELDS(CAMERA_POOL_SWAP)
+#undef CAMERA_POOL_SWAP
+
+    const uint32_t slot = _registry->pool_slot[_a];
+    _registry->pool_slot[_a] = _registry->pool_slot[_b];
+    _registry->pool_slot[_b] = slot;
+    _registry->slot_index[_registry->pool_slot[_a]] = _a;
+    _registry->slot_index[_registry->pool_slot[_b]] = _b;
+}
+
+extern uint32_t camera_registry_compact(CameraRegistry* _registry)
+{
+    const uint32_t count = _registry->pool.count;
+    const uint32_t* modes = _registry->pool.mode;
+    CameraRegistryGroup* groups = _registry->groups;
+    uint32_t* destination = _registry->scratch;
+
+    // Distinct modes in ascending order, the last group collects the overflow
+    uint32_t groupCount = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t g = 0;
+        while (g < groupCount && groups[g].mode < modes[i])
+        {
+            g++;
+        }
+        if (g < groupCount && groups[g].mode == modes[i])
+        {
+            continue;
+        }
+        if (groupCount == CAMERA_REGISTRY_MAX_GROUPS)
+        {
+            // Merge into the mixed group (always the last, as it has the largest mode)
+            groups[CAMERA_REGISTRY_MAX_GROUPS - 1].mode = CAMERA_REGISTRY_MIXED_MODE;
+            continue;
+        }
+        for (uint32_t k = groupCount; k > g; --k)
+        {
+            groups[k] = groups[k - 1];
+        }
+        groups[g].mode = modes[i];
+        groupCount++;
+    }
+
+    // Group sizes, then the destination of every camera (stable within a group)
+    for (uint32_t g = 0; g < groupCount; ++g)
+    {
+        groups[g].begin = 0;
+        groups[g].end = 0;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t g = 0;
+        while (g + 1 < groupCount && groups[g].mode != modes[i])
+        {
+            g++;
+        }
+        destination[i] = g;
+        groups[g].end++;
+    }
+    uint32_t begin = 0;
+    for (uint32_t g = 0; g < groupCount; ++g)
+    {
+        const uint32_t size = groups[g].end;
+        groups[g].begin = begin;
+        groups[g].end = begin; // Advanced below
+        begin += size;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        destination[i] = groups[destination[i]].end++;
+    }
+
+    // Apply the permutation by following its cycles, every swap puts one camera at its destination
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        while (destination[i] != i)
+        {
+            const uint32_t j = destination[i];
+            camera__registry_swap(_registry, i, j);
+            destination[i] = destination[j];
+            destination[j] = j;
+        }
+    }
+
+    _registry->group_count = groupCount;
+    return groupCount;
+}
+
+extern void camera_view_matrix_batch(CameraPool* _pool, float* _out_matrices)
+{
+    camera_pool_update(_pool, 0, _pool->count, _out_matrices);
+}
+
+extern void camera_view_matrix_batch_output(CameraPool* _pool, const CameraOutput* _output)
+{
+    camera_pool_update_output(_pool, 0, _pool->count, _output);
+}
+
+extern void camera_view_matrix_interpolated_batch(const CameraPool* _pool, float _alpha, float* _out_matrices)
+{
+    const CameraPool pool = *_pool;
+
+    for (uint32_t i = 0; i < pool.count; ++i)
+    {
+        camera__interpolate(
+            cm_init_vec3(pool.previous_position_x[i], pool.previous_position_y[i], pool.previous_position_z[i]),
+            pool.previous_distance[i],
+            cm_init_quat(pool.previous_orientation_x[i], pool.previous_orientation_y[i], pool.previous_orientation_z[i], pool.previous_orientation_w[i]),
+            cm_init_vec3(pool.view_position_x[i], pool.view_position_y[i], pool.view_position_z[i]),
+            pool.view_distance[i],
+            cm_init_quat(pool.view_orientation_x[i], pool.view_orientation_y[i], pool.view_orientation_z[i], pool.view_orientation_w[i]),
+            pool.boom_distance[i], _alpha, _out_matrices + 16 * i);
+    }
+}
+
+// CAMERA_POOL_LANES consecutive cameras of a pool, copied out of the pool arrays one array at a time
+//  The lane kernel works on this local copy. Its arrays can not alias each other, so the loops over the lanes vectorize.
+typedef struct camera__pool_lanes {
+#define CAMERA_POOL_DECLARE_LANES(_type, _array, _member) _type _array[CAMERA_POOL_LANES];
+    CAMERA_POOL_STATE_FIELDS(CAMERA_POOL_DECLARE_LANES)
+#undef CAMERA_POOL_DECLARE_LANES
+    float movement_x[CAMERA_POOL_LANES];    // Pending input, already taken out of the accumulators
+    float movement_y[CAMERA_POOL_LANES];
+    float movement_z[CAMERA_POOL_LANES];
+    float rotation_x[CAMERA_POOL_LANES];
+    float rotation_y[CAMERA_POOL_LANES];
+    float rotation_z[CAMERA_POOL_LANES];
+    uint32_t idle[CAMERA_POOL_LANES];       // 1 if the lane takes the early-out
+    uint32_t kernel[CAMERA_POOL_LANES];     // 1 if the lane kernel updates the lane. Lanes that are neither are updated by camera__update(..).
+} Camera__PoolLanes;
+
+#define CAMERA_POOL_LOAD_LANES(_type, _array, _member) \
+    { \
+        _type const* array = _pool->_array + _first; \
+        for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i) { _lanes->_array[i] = array[i]; } \
+    }
+#define CAMERA_POOL_STORE_LANES(_type, _array, _member) \
+    { \
+        _type* array = _pool->_array + _first; \
+        for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i) { array[i] = _lanes->_array[i]; } \
+    }
+
+// Take the pending input of cameras [_first; _first + _count) out of the accumulators
+static CAMERA__FORCE_INLINE void camera__pool_take_input(CameraPool* _pool, uint32_t _first, uint32_t _count, Camera__PoolLanes* _lanes)
+{
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+        const uint32_t index = _first + i;
+        camera__clear_dirty(&_pool->dirty[index]);
+        _lanes->movement_x[i] = camera__drain_component(&_pool->movement_accumulator_x[index]);
+        _lanes->movement_y[i] = camera__drain_component(&_pool->movement_accumulator_y[index]);
+        _lanes->movement_z[i] = camera__drain_component(&_pool->movement_accumulator_z[index]);
+        _lanes->rotation_x[i] = camera__drain_component(&_pool->rotation_accumulator_x[index]);
+        _lanes->rotation_y[i] = camera__drain_component(&_pool->rotation_accumulator_y[index]);
+        _lanes->rotation_z[i] = camera__drain_component(&_pool->rotation_accumulator_z[index]);
+    }
+}
+
+// Copy cameras [_first; _first + CAMERA_POOL_LANES) out of the pool arrays
+//  Only the members the early-out reads are copied, camera__pool_load_kernel(..) adds the rest.
+static CAMERA__FORCE_INLINE void camera__pool_load_lanes(const CameraPool* _pool, uint32_t _first, Camera__PoolLanes* _lanes)
+{
+    CAMERA_POOL_SETTINGS_FIELDS(CAMERA_POOL_LOAD_LANES)
+    CAMERA_POOL_UPDATED_FIELDS(CAMERA_POOL_LOAD_LANES)
+    CAMERA_POOL_BASIS_FIELDS(CAMERA_POOL_LOAD_LANES)
+}
+
+// Copy the remaining members the lane kernel reads and writes back as _mode
+static CAMERA__FORCE_INLINE void camera__pool_load_kernel(const CameraPool* _pool, uint32_t _first, uint32_t _mode,
+    Camera__PoolLanes* _lanes)
+{
+    CAMERA_POOL_VELOCITY_FIELDS(CAMERA_POOL_LOAD_LANES)
+
+    if (_mode & (CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE))
+    {
+        CAMERA_POOL_ANGLE_FIELDS(CAMERA_POOL_LOAD_LANES)
+    }
+}
+
+// Copy the lanes back into the pool arrays
+//  _idle is set if no lane went through the lane kernel, then only the previous state changed.
+//  Lanes left to camera__update(..) are stored unchanged, except for their previous state, which camera__update(..) overwrites.
+static CAMERA__FORCE_INLINE void camera__pool_store_lanes(CameraPool* _pool, uint32_t _first, uint32_t _mode, bool _idle,
+    const Camera__PoolLanes* _lanes)
+{
+    CAMERA_POOL_PREVIOUS_FIELDS(CAMERA_POOL_STORE_LANES)
+
+    if (_idle)
+    {
+        return;
+    }
+
+    CAMERA_POOL_UPDATED_FIELDS(CAMERA_POOL_STORE_LANES)
+    CAMERA_POOL_VELOCITY_FIELDS(CAMERA_POOL_STORE_LANES)
+    CAMERA_POOL_BASIS_FIELDS(CAMERA_POOL_STORE_LANES)
+
+    if (_mode & (CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE))
+    {
+        CAMERA_POOL_ANGLE_FIELDS(CAMERA_POOL_STORE_LANES)
+    }
+}
+
+#undef CAMERA_POOL_LOAD_LANES
+#undef CAMERA_POOL_STORE_LANES
+
+// _take ? _new : _old of one lane, _take is 0 or 1
+//  Selects the bits with a mask. The compiler turns ?: into a branch if it can sink the computation of _new into it,
+//   which keeps the loops over the lanes from vectorizing.
+static CAMERA__FORCE_INLINE float camera__lane_select(uint32_t _take, float _new, float _old)
+{
+    uint32_t a, b;
+    memcpy(&a, &_new, sizeof(a));
+    memcpy(&b, &_old, sizeof(b));
+
+    const uint32_t mask = 0u - _take;
+    const uint32_t bits = (a & mask) | (b & ~mask);
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// Sort the lanes into early-outs, lanes for the lane kernel and the rest, returns the number of lanes for the lane kernel
+//  The lane kernel updates cameras as _mode without smoothing and floating origin. Clamped angles have to be tracked
+//   (see "Clamp angles" in camera__update(..)) and the orientation close to unit length, as a full normalization is left
+//   to camera__update(..). Rotating by a unit quaternion keeps the length, so half the bound of camera__renormalize(..) is enough.
+//  Unless _specialized, cameras of another mode than _mode are left to camera__update(..).
+//  The conditions are combined with & instead of &&, so the loop has no branches.
+static CAMERA__FORCE_INLINE uint32_t camera__lanes_classify(Camera__PoolLanes* _lanes, bool _specialized, uint32_t _mode)
+{
+    const uint32_t clamping = (_mode & (CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE)) != 0;
+    const uint32_t supported = !(_mode & CAMERA_MODE_FLOATING_ORIGIN) && (!clamping || (_mode & CAMERA_MODE_DISABLE_ROLL));
+
+    // Pointers and floats in one loop keep it from vectorizing
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        _lanes->kernel[i] = _lanes->smoothing[i] == NULL;
+    }
+
+    uint32_t kernel = 0;
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        // Same as camera__is_idle(..)
+        const uint32_t input = (_lanes->movement_x[i] != 0.0f) | (_lanes->movement_y[i] != 0.0f) | (_lanes->movement_z[i] != 0.0f)
+            | (_lanes->rotation_x[i] != 0.0f) | (_lanes->rotation_y[i] != 0.0f) | (_lanes->rotation_z[i] != 0.0f);
+        const uint32_t oriented = (_lanes->orientation_x[i] == _lanes->applied_orientation_x[i])
+            & (_lanes->orientation_y[i] == _lanes->applied_orientation_y[i])
+            & (_lanes->orientation_z[i] == _lanes->applied_orientation_z[i])
+            & (_lanes->orientation_w[i] == _lanes->applied_orientation_w[i]);
+        const uint32_t tracked = (_lanes->generation[i] != 0) & (_lanes->mode[i] == _lanes->applied_mode[i]) & oriented;
+        const uint32_t unchanged = tracked
+            & (_lanes->target_position_x[i] == _lanes->applied_position_x[i])
+            & (_lanes->target_position_y[i] == _lanes->applied_position_y[i])
+            & (_lanes->target_position_z[i] == _lanes->applied_position_z[i])
+            & (_lanes->target_distance[i] == _lanes->applied_distance[i])
+            & (_lanes->minPitch[i] == _lanes->applied_minPitch[i]) & (_lanes->maxPitch[i] == _lanes->applied_maxPitch[i])
+            & (_lanes->minYaw[i] == _lanes->applied_minYaw[i]) & (_lanes->maxYaw[i] == _lanes->applied_maxYaw[i])
+            & (_lanes->minRoll[i] == _lanes->applied_minRoll[i]) & (_lanes->maxRoll[i] == _lanes->applied_maxRoll[i])
+            & (_lanes->boom_distance[i] == _lanes->applied_boom_distance[i]);
+        const uint32_t settled = (_lanes->view_position_x[i] == _lanes->target_position_x[i])
+            & (_lanes->view_position_y[i] == _lanes->target_position_y[i])
+            & (_lanes->view_position_z[i] == _lanes->target_position_z[i])
+            & (_lanes->view_distance[i] == _lanes->target_distance[i])
+            & (_lanes->view_orientation_x[i] == _lanes->orientation_x[i])
+            & (_lanes->view_orientation_y[i] == _lanes->orientation_y[i])
+            & (_lanes->view_orientation_z[i] == _lanes->orientation_z[i])
+            & (_lanes->view_orientation_w[i] == _lanes->orientation_w[i]);
+        const uint32_t idle = (input ^ 1) & unchanged & settled;
+
+        const float error = _lanes->orientation_x[i] * _lanes->orientation_x[i] + _lanes->orientation_y[i] * _lanes->orientation_y[i]
+            + _lanes->orientation_z[i] * _lanes->orientation_z[i] + _lanes->orientation_w[i] * _lanes->orientation_w[i] - 1.0f;
+
+        const uint32_t lane = _lanes->kernel[i] & supported & (idle ^ 1) & (_specialized | (_lanes->mode[i] == _mode))
+            & ((clamping ^ 1) | tracked) & (error < 0.005f) & (error > -0.005f);
+        _lanes->idle[i] = idle;
+        _lanes->kernel[i] = lane;
+        kernel += lane;
+
+        CAMERA__PROFILE_COUNT(updates, idle | lane);
+        CAMERA__PROFILE_COUNT(early_outs, idle);
+    }
+    return kernel;
+}
+
+// camera__retain_previous(..) of every lane
+static CAMERA__FORCE_INLINE void camera__lanes_retain_previous(Camera__PoolLanes* _lanes)
+{
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        const uint32_t updated = _lanes->generation[i] != 0;
+        _lanes->previous_position_x[i] = camera__lane_select(updated, _lanes->view_position_x[i], _lanes->target_position_x[i]);
+        _lanes->previous_position_y[i] = camera__lane_select(updated, _lanes->view_position_y[i], _lanes->target_position_y[i]);
+        _lanes->previous_position_z[i] = camera__lane_select(updated, _lanes->view_position_z[i], _lanes->target_position_z[i]);
+        _lanes->previous_distance[i] = camera__lane_select(updated, _lanes->view_distance[i], _lanes->target_distance[i]);
+        _lanes->previous_orientation_x[i] = camera__lane_select(updated, _lanes->view_orientation_x[i], _lanes->orientation_x[i]);
+        _lanes->previous_orientation_y[i] = camera__lane_select(updated, _lanes->view_orientation_y[i], _lanes->orientation_y[i]);
+        _lanes->previous_orientation_z[i] = camera__lane_select(updated, _lanes->view_orientation_z[i], _lanes->orientation_z[i]);
+        _lanes->previous_orientation_w[i] = camera__lane_select(updated, _lanes->view_orientation_w[i], _lanes->orientation_w[i]);
+    }
+}
+
+// Lane kernel, camera__update(..) of the lanes classified for it, updated as _mode
+//  Each step of camera__update(..) is one loop over the lanes. Every lane is computed, but only the kernel lanes take
+//   the result, the others keep their values. The math backend is only called per lane (cm_sincos(..), cm_mulQuat(..) and cm_normalizeVec3(..)),
+//   so every lane rounds like camera__update(..). These calls get loops of their own, the other loops vectorize.
+//  Also retains the previous state of every lane.
+static CAMERA__FORCE_INLINE void camera__lanes_update(Camera__PoolLanes* _lanes, uint32_t _mode)
+{
+    const bool clamping = (_mode & (CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE)) != 0;
+
+    float pitch[CAMERA_POOL_LANES], yaw[CAMERA_POOL_LANES], roll[CAMERA_POOL_LANES];
+
+
+    /* Clamp angles */
+
+    if (clamping)
+    {
+        CAMERA__PROFILE_BEGIN(CAMERA_PROFILE_PHASE_CLAMP, camera_clamp);
+    }
+
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        float x = _lanes->rotation_x[i];
+        float y = _lanes->rotation_y[i];
+        float z = _lanes->rotation_z[i];
+
+        if (_mode & CAMERA_MODE_CLAMP_PITCH_ANGLE)
+        {
+            x = cm_max(_lanes->minPitch[i] - _lanes->angles_x[i], x);
+            x = cm_min(_lanes->maxPitch[i] - _lanes->angles_x[i], x);
+        }
+
+        if (_mode & CAMERA_MODE_CLAMP_YAW_ANGLE)
+        {
+            y = cm_max(_lanes->minYaw[i] - _lanes->angles_y[i], y);
+            y = cm_min(_lanes->maxYaw[i] - _lanes->angles_y[i], y);
+        }
+
+        if (_mode & CAMERA_MODE_CLAMP_ROLL_ANGLE)
+        {
+            z = cm_max(_lanes->minRoll[i] - _lanes->angles_z[i], z);
+            z = cm_min(_lanes->maxRoll[i] - _lanes->angles_z[i], z);
+        }
+
+        pitch[i] = x;
+        yaw[i] = y;
+        roll[i] = z;
+    }
+
+    if (clamping)
+    {
+        CAMERA__PROFILE_END(camera_clamp);
+    }
+
+
+    /* Update orientation */
+
+    CAMERA__PROFILE_BEGIN(CAMERA_PROFILE_PHASE_ORIENTATION, camera_orientation);
+
+    // Half angle sine and cosine of each axis rotation, only kernel lanes with a rotation around the axis call cm_sincos(..)
+    float sp[CAMERA_POOL_LANES], cp[CAMERA_POOL_LANES];
+    float sy[CAMERA_POOL_LANES], cy[CAMERA_POOL_LANES];
+    float sr[CAMERA_POOL_LANES], cr[CAMERA_POOL_LANES];
+
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        sp[i] = 0.0f;
+        cp[i] = 1.0f;
+        sy[i] = 0.0f;
+        cy[i] = 1.0f;
+        sr[i] = 0.0f;
+        cr[i] = 1.0f;
+
+        if (!_lanes->kernel[i])
+        {
+            continue;
+        }
+
+        if (pitch[i] != 0.0f)
+        {
+            cm_sincos(pitch[i] * 0.5f, &sp[i], &cp[i]);
+            CAMERA__PROFILE_COUNT(sincos, 1);
+            sp[i] *= CAMERA_WORLD_RIGHT.x;
+        }
+
+        if (yaw[i] != 0.0f)
+        {
+            cm_sincos(yaw[i] * 0.5f, &sy[i], &cy[i]);
+            CAMERA__PROFILE_COUNT(sincos, 1);
+            sy[i] *= CAMERA_WORLD_UP.y;
+        }
+
+        if (!(_mode & CAMERA_MODE_DISABLE_ROLL) && roll[i] != 0.0f)
+        {
+            cm_sincos(roll[i] * 0.5f, &sr[i], &cr[i]);
+            CAMERA__PROFILE_COUNT(sincos, 1);
+            sr[i] *= CAMERA_WORLD_FORWARD.z;
+        }
+    }
+
+    // Rotated orientation of every lane
+    float x[CAMERA_POOL_LANES], y[CAMERA_POOL_LANES], z[CAMERA_POOL_LANES], w[CAMERA_POOL_LANES];
+
+    if (_mode & CAMERA_MODE_DISABLE_ROLL)
+    {
+        // orientation = yaw * orientation * pitch
+        for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+        {
+            const float qx = _lanes->orientation_x[i];
+            const float qy = _lanes->orientation_y[i];
+            const float qz = _lanes->orientation_z[i];
+            const float qw = _lanes->orientation_w[i];
+
+            const float px = qw * sp[i] + qx * cp[i];
+            const float py = qy * cp[i] + qz * sp[i];
+            const float pz = qz * cp[i] - qy * sp[i];
+            const float pw = qw * cp[i] - qx * sp[i];
+
+            x[i] = cy[i] * px + sy[i] * pz;
+            y[i] = cy[i] * py + sy[i] * pw;
+            z[i] = cy[i] * pz - sy[i] * px;
+            w[i] = cy[i] * pw - sy[i] * py;
+        }
+
+        if (clamping)
+        {
+            // camera__wrap_angle(..) as selects
+            const float pi = 3.14159265358979f;
+
+            for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+            {
+                const uint32_t kernel = _lanes->kernel[i];
+                const float x = _lanes->angles_x[i] + pitch[i];
+                const float y = _lanes->angles_y[i] + yaw[i];
+                const float wrapped_x = camera__lane_select(x > pi, x - 2.0f * pi, camera__lane_select(x < -pi, x + 2.0f * pi, x));
+                const float wrapped_y = camera__lane_select(y > pi, y - 2.0f * pi, camera__lane_select(y < -pi, y + 2.0f * pi, y));
+                _lanes->angles_x[i] = camera__lane_select(kernel, wrapped_x, _lanes->angles_x[i]);
+                _lanes->angles_y[i] = camera__lane_select(kernel, wrapped_y, _lanes->angles_y[i]);
+            }
+        }
+    }
+    else
+    {
+        // orientation = orientation * (pitch * yaw * roll)
+        for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+        {
+            const float ax = sp[i] * cy[i];
+            const float ay = cp[i] * sy[i];
+            const float az = sp[i] * sy[i];
+            const float aw = cp[i] * cy[i];
+
+            const CameraQuat rotation = cm_init_quat(
+                ax * cr[i] + ay * sr[i],
+                ay * cr[i] - ax * sr[i],
+                aw * sr[i] + az * cr[i],
+                aw * cr[i] - az * sr[i]
+            );
+
+            const CameraQuat orientation = cm_init_quat(_lanes->orientation_x[i], _lanes->orientation_y[i], _lanes->orientation_z[i],
+                _lanes->orientation_w[i]);
+            const CameraQuat q = cm_mulQuat(orientation, rotation);
+            x[i] = q.x;
+            y[i] = q.y;
+            z[i] = q.z;
+            w[i] = q.w;
+        }
+    }
+
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        const uint32_t kernel = _lanes->kernel[i];
+
+        // camera__renormalize(..), the orientation is close enough to unit length for the first order correction
+        const float norm2 = x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + w[i] * w[i];
+        const float error = norm2 - 1.0f;
+        const uint32_t drifted = (error > CAMERA_NORMALIZE_EPSILON) | (error < -CAMERA_NORMALIZE_EPSILON);
+        const float scale = camera__lane_select(drifted, 1.5f - 0.5f * norm2, 1.0f);
+        CAMERA__PROFILE_COUNT(renormalizations, kernel & drifted);
+
+        const float qx = camera__lane_select(kernel, x[i] * scale, _lanes->orientation_x[i]);
+        const float qy = camera__lane_select(kernel, y[i] * scale, _lanes->orientation_y[i]);
+        const float qz = camera__lane_select(kernel, z[i] * scale, _lanes->orientation_z[i]);
+        const float qw = camera__lane_select(kernel, w[i] * scale, _lanes->orientation_w[i]);
+        _lanes->orientation_x[i] = qx;
+        _lanes->orientation_y[i] = qy;
+        _lanes->orientation_z[i] = qz;
+        _lanes->orientation_w[i] = qw;
+
+
+        /* Update basis vectors */
+
+        // Columns of cm_matrixFromQuat(..)
+        const float x2 = qx + qx;
+        const float y2 = qy + qy;
+        const float z2 = qz + qz;
+        const float x2x = x2 * qx;
+        const float x2y = x2 * qy;
+        const float x2z = x2 * qz;
+        const float x2w = x2 * qw;
+        const float y2y = y2 * qy;
+        const float y2z = y2 * qz;
+        const float y2w = y2 * qw;
+        const float z2z = z2 * qz;
+        const float z2w = z2 * qw;
+
+        _lanes->right_x[i] = camera__lane_select(kernel, 1.0f - (y2y + z2z), _lanes->right_x[i]);
+        _lanes->right_y[i] = camera__lane_select(kernel, x2y + z2w, _lanes->right_y[i]);
+        _lanes->right_z[i] = camera__lane_select(kernel, x2z - y2w, _lanes->right_z[i]);
+        _lanes->up_x[i] = camera__lane_select(kernel, x2y - z2w, _lanes->up_x[i]);
+        _lanes->up_y[i] = camera__lane_select(kernel, 1.0f - (x2x + z2z), _lanes->up_y[i]);
+        _lanes->up_z[i] = camera__lane_select(kernel, y2z + x2w, _lanes->up_z[i]);
+        _lanes->forward_x[i] = camera__lane_select(kernel, x2z + y2w, _lanes->forward_x[i]);
+        _lanes->forward_y[i] = camera__lane_select(kernel, y2z - x2w, _lanes->forward_y[i]);
+        _lanes->forward_z[i] = camera__lane_select(kernel, 1.0f - (x2x + y2y), _lanes->forward_z[i]);
+    }
+
+    CAMERA__PROFILE_END(camera_orientation);
+
+
+    /* Update target_position */
+
+    CAMERA__PROFILE_BEGIN(CAMERA_PROFILE_PHASE_POSITION, camera_position);
+
+    // Movement directions
+    float forward_x[CAMERA_POOL_LANES], forward_y[CAMERA_POOL_LANES], forward_z[CAMERA_POOL_LANES];
+    float up_x[CAMERA_POOL_LANES], up_y[CAMERA_POOL_LANES], up_z[CAMERA_POOL_LANES];
+    float right_x[CAMERA_POOL_LANES], right_y[CAMERA_POOL_LANES], right_z[CAMERA_POOL_LANES];
+
+    if (_mode & CAMERA_MODE_MOVE_IN_WORLDPLANE)
+    {
+        const float epsilon = 0.0001f; // Avoid floating point errors
+        const CameraVec3 world_up = CAMERA_WORLD_UP;
+
+        // The special cases of camera__update(..) as selects, then the projection into the world plane
+        for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+        {
+            const float fx = _lanes->forward_x[i];
+            const float fy = _lanes->forward_y[i];
+            const float fz = _lanes->forward_z[i];
+            const float rx = _lanes->right_x[i];
+            const float ry = _lanes->right_y[i];
+            const float rz = _lanes->right_z[i];
+            const float ux = _lanes->up_x[i];
+            const float uz = _lanes->up_z[i];
+            const uint32_t up = fy > 1.0f - epsilon;
+            const uint32_t down = (up ^ 1) & (fy < -1.0f + epsilon);
+            const uint32_t right_up = (up ^ 1) & (down ^ 1) & (ry > 1.0f - epsilon);
+            const uint32_t right_down = (up ^ 1) & (down ^ 1) & (right_up ^ 1) & (ry < -1.0f + epsilon);
+
+            forward_x[i] = camera__lane_select(up, -ux, camera__lane_select(down, ux, fx));
+            forward_z[i] = camera__lane_select(up, -uz, camera__lane_select(down, uz, fz));
+            right_x[i] = camera__lane_select(right_up, ux, camera__lane_select(right_down, -ux, rx));
+            right_z[i] = camera__lane_select(right_up, uz, camera__lane_select(right_down, -uz, rz));
+            up_x[i] = world_up.x;
+            up_y[i] = world_up.y;
+            up_z[i] = world_up.z;
+        }
+
+        for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+        {
+            const CameraVec3 forward = cm_normalizeVec3(cm_init_vec3(forward_x[i], 0.0f, forward_z[i]));
+            const CameraVec3 right = cm_normalizeVec3(cm_init_vec3(right_x[i], 0.0f, right_z[i]));
+            forward_x[i] = forward.x;
+            forward_y[i] = forward.y;
+            forward_z[i] = forward.z;
+            right_x[i] = right.x;
+            right_y[i] = right.y;
+            right_z[i] = right.z;
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+        {
+            forward_x[i] = _lanes->forward_x[i];
+            forward_y[i] = _lanes->forward_y[i];
+            forward_z[i] = _lanes->forward_z[i];
+            up_x[i] = _lanes->up_x[i];
+            up_y[i] = _lanes->up_y[i];
+            up_z[i] = _lanes->up_z[i];
+            right_x[i] = _lanes->right_x[i];
+            right_y[i] = _lanes->right_y[i];
+            right_z[i] = _lanes->right_z[i];
+        }
+    }
+
+    // Add forward, up and right scaled by the movement in the order of camera__update(..)
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        const uint32_t kernel = _lanes->kernel[i];
+        const float mx = _lanes->movement_x[i];
+        const float my = _lanes->movement_y[i];
+        const float mz = _lanes->movement_z[i];
+        const float tx = _lanes->target_position_x[i];
+        const float ty = _lanes->target_position_y[i];
+        const float tz = _lanes->target_position_z[i];
+        _lanes->target_position_x[i] = camera__lane_select(kernel, tx + forward_x[i] * mx + up_x[i] * my + right_x[i] * mz, tx);
+        _lanes->target_position_y[i] = camera__lane_select(kernel, ty + forward_y[i] * mx + up_y[i] * my + right_y[i] * mz, ty);
+        _lanes->target_position_z[i] = camera__lane_select(kernel, tz + forward_z[i] * mx + up_z[i] * my + right_z[i] * mz, tz);
+    }
+
+
+    /* Update view state */
+
+    camera__lanes_retain_previous(_lanes);
+
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        const uint32_t kernel = _lanes->kernel[i];
+
+        // Without smoothing the view state is the camera state
+        _lanes->view_position_x[i] = camera__lane_select(kernel, _lanes->target_position_x[i], _lanes->view_position_x[i]);
+        _lanes->view_position_y[i] = camera__lane_select(kernel, _lanes->target_position_y[i], _lanes->view_position_y[i]);
+        _lanes->view_position_z[i] = camera__lane_select(kernel, _lanes->target_position_z[i], _lanes->view_position_z[i]);
+        _lanes->view_distance[i] = camera__lane_select(kernel, _lanes->target_distance[i], _lanes->view_distance[i]);
+        _lanes->view_orientation_x[i] = camera__lane_select(kernel, _lanes->orientation_x[i], _lanes->view_orientation_x[i]);
+        _lanes->view_orientation_y[i] = camera__lane_select(kernel, _lanes->orientation_y[i], _lanes->view_orientation_y[i]);
+        _lanes->view_orientation_z[i] = camera__lane_select(kernel, _lanes->orientation_z[i], _lanes->view_orientation_z[i]);
+        _lanes->view_orientation_w[i] = camera__lane_select(kernel, _lanes->orientation_w[i], _lanes->view_orientation_w[i]);
+        _lanes->position_velocity_x[i] = camera__lane_select(kernel, 0.0f, _lanes->position_velocity_x[i]);
+        _lanes->position_velocity_y[i] = camera__lane_select(kernel, 0.0f, _lanes->position_velocity_y[i]);
+        _lanes->position_velocity_z[i] = camera__lane_select(kernel, 0.0f, _lanes->position_velocity_z[i]);
+        _lanes->distance_velocity[i] = camera__lane_select(kernel, 0.0f, _lanes->distance_velocity[i]);
+        _lanes->orientation_velocity_x[i] = camera__lane_select(kernel, 0.0f, _lanes->orientation_velocity_x[i]);
+        _lanes->orientation_velocity_y[i] = camera__lane_select(kernel, 0.0f, _lanes->orientation_velocity_y[i]);
+        _lanes->orientation_velocity_z[i] = camera__lane_select(kernel, 0.0f, _lanes->orientation_velocity_z[i]);
+        _lanes->orientation_velocity_w[i] = camera__lane_select(kernel, 0.0f, _lanes->orientation_velocity_w[i]);
+
+
+        /* Update eye */
+
+        const float distance = -cm_min(_lanes->view_distance[i], _lanes->boom_distance[i]);
+        _lanes->eye_x[i] = camera__lane_select(kernel, _lanes->view_position_x[i] + _lanes->forward_x[i] * distance, _lanes->eye_x[i]);
+        _lanes->eye_y[i] = camera__lane_select(kernel, _lanes->view_position_y[i] + _lanes->forward_y[i] * distance, _lanes->eye_y[i]);
+        _lanes->eye_z[i] = camera__lane_select(kernel, _lanes->view_position_z[i] + _lanes->forward_z[i] * distance, _lanes->eye_z[i]);
+
+
+        /* Remember applied state */
+
+        _lanes->applied_position_x[i] = camera__lane_select(kernel, _lanes->target_position_x[i], _lanes->applied_position_x[i]);
+        _lanes->applied_position_y[i] = camera__lane_select(kernel, _lanes->target_position_y[i], _lanes->applied_position_y[i]);
+        _lanes->applied_position_z[i] = camera__lane_select(kernel, _lanes->target_position_z[i], _lanes->applied_position_z[i]);
+        _lanes->applied_distance[i] = camera__lane_select(kernel, _lanes->target_distance[i], _lanes->applied_distance[i]);
+        _lanes->applied_orientation_x[i] = camera__lane_select(kernel, _lanes->orientation_x[i], _lanes->applied_orientation_x[i]);
+        _lanes->applied_orientation_y[i] = camera__lane_select(kernel, _lanes->orientation_y[i], _lanes->applied_orientation_y[i]);
+        _lanes->applied_orientation_z[i] = camera__lane_select(kernel, _lanes->orientation_z[i], _lanes->applied_orientation_z[i]);
+        _lanes->applied_orientation_w[i] = camera__lane_select(kernel, _lanes->orientation_w[i], _lanes->applied_orientation_w[i]);
+        _lanes->applied_minPitch[i] = camera__lane_select(kernel, _lanes->minPitch[i], _lanes->applied_minPitch[i]);
+        _lanes->applied_maxPitch[i] = camera__lane_select(kernel, _lanes->maxPitch[i], _lanes->applied_maxPitch[i]);
+        _lanes->applied_minYaw[i] = camera__lane_select(kernel, _lanes->minYaw[i], _lanes->applied_minYaw[i]);
+        _lanes->applied_maxYaw[i] = camera__lane_select(kernel, _lanes->maxYaw[i], _lanes->applied_maxYaw[i]);
+        _lanes->applied_minRoll[i] = camera__lane_select(kernel, _lanes->minRoll[i], _lanes->applied_minRoll[i]);
+        _lanes->applied_maxRoll[i] = camera__lane_select(kernel, _lanes->maxRoll[i], _lanes->applied_maxRoll[i]);
+        _lanes->applied_boom_distance[i] = camera__lane_select(kernel, _lanes->boom_distance[i], _lanes->applied_boom_distance[i]);
+    }
+
+    // Integer selects in the float loop above keep it from vectorizing
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        const uint32_t kernel = _lanes->kernel[i];
+        const uint32_t mode = _lanes->mode[i];
+        const uint32_t applied_mode = _lanes->applied_mode[i];
+        _lanes->applied_mode[i] = kernel ? mode : applied_mode;
+        _lanes->generation[i] += kernel;
+    }
+
+    CAMERA__PROFILE_END(camera_position);
+}
+
+// Write the view matrices of the early-out and kernel lanes, see camera__write_view_matrix(..)
+static CAMERA__FORCE_INLINE void camera__lanes_write_view_matrices(const Camera__PoolLanes* _lanes, uint32_t _first,
+    float* _out_matrices, const CameraOutput* _output)
+{
+    CAMERA__PROFILE_BEGIN(CAMERA_PROFILE_PHASE_MATRIX, camera_matrix);
+
+    for (uint32_t i = 0; i < CAMERA_POOL_LANES; ++i)
+    {
+        if (!_lanes->idle[i] && !_lanes->kernel[i])
+        {
+            continue;
+        }
+
+        const CameraVec3 right = cm_init_vec3(_lanes->right_x[i], _lanes->right_y[i], _lanes->right_z[i]);
+        const CameraVec3 up = cm_init_vec3(_lanes->up_x[i], _lanes->up_y[i], _lanes->up_z[i]);
+        const CameraVec3 forward = cm_init_vec3(_lanes->forward_x[i], _lanes->forward_y[i], _lanes->forward_z[i]);
+        const CameraVec3 eye = cm_init_vec3(_lanes->eye_x[i], _lanes->eye_y[i], _lanes->eye_z[i]);
+
+        if (_output != NULL)
+        {
+            camera__output_view(_output, _first + i, right, up, forward, eye);
+        }
+        else
+        {
+            camera__write_view(right, up, forward, eye, _out_matrices + 16 * (size_t)(_first + i));
+        }
+    }
+
+    CAMERA__PROFILE_END(camera_matrix);
+}
+
+// Early-out and lane kernel of the cameras [_first; _first + CAMERA_POOL_LANES), updated as _mode
+//  Leaves the lanes that are neither idle nor kernel lanes to camera__update(..), see camera__lanes_classify(..).
+static CAMERA__FORCE_INLINE void camera__pool_update_lanes(CameraPool* _pool, uint32_t _first, Camera__PoolLanes* _lanes, bool _specialized,
+    uint32_t _mode, float* _out_matrices, const CameraOutput* _output)
+{
+    const uint32_t kernel = camera__lanes_classify(_lanes, _specialized, _mode);
+    if (kernel > 0)
+    {
+        camera__pool_load_kernel(_pool, _first, _mode, _lanes);
+        camera__lanes_update(_lanes, _mode);
+    }
+    else
+    {
+        camera__lanes_retain_previous(_lanes);
+    }
+    camera__pool_store_lanes(_pool, _first, _mode, kernel == 0, _lanes);
+    camera__lanes_write_view_matrices(_lanes, _first, _out_matrices, _output);
+}
+
+// Shared loop of camera_pool_update(..), camera_pool_update_output(..) and their mode specializations
+//  If _specialized is set, every camera is updated as _mode instead of its own mode.
+//  If _output is set, the matrices are written as described by it instead of to _out_matrices.
+//  The cameras are updated in groups of CAMERA_POOL_LANES. The early-out test and the lane kernel run over the whole group,
+//   the remaining cameras of the group are updated one by one by camera__update(..), as are the cameras of a last partial group.
+//  Unless _specialized, the lane kernel updates the cameras of the mode of the first camera in the group. The built-in modes
+//   get a lane kernel of their own with the mode branches resolved when compiling.
+static CAMERA__FORCE_INLINE void camera__pool_update(CameraPool* _pool, uint32_t _begin, uint32_t _end, float* _out_matrices,
+    const CameraOutput* _output, bool _specialized, uint32_t _mode)
+{
+    // camera__update(..) works on a local copy of each camera, holding only the members its mode uses
+    Camera cam = camera_init();
+    Camera__PoolLanes lanes;
+
+    // Local copy of the array pointers, otherwise every store into an array could alias them and force a reload
+    CameraPool pool = *_pool;
+
+    const uint32_t end = _end < pool.count ? _end : pool.count;
+    for (uint32_t first = _begin; first < end; first += CAMERA_POOL_LANES)
+    {
+        const uint32_t count = end - first < CAMERA_POOL_LANES ? end - first : CAMERA_POOL_LANES;
+        camera__pool_take_input(&pool, first, count, &lanes);
+
+        if (count == CAMERA_POOL_LANES)
+        {
+            camera__pool_load_lanes(&pool, first, &lanes);
+
+            if (_specialized)
+            {
+                camera__pool_update_lanes(&pool, first, &lanes, true, _mode, _out_matrices, _output);
+            }
+            else
+            {
+                switch (lanes.mode[0])
+                {
+                case CAMERA_MODE_FREE:
+                    camera__pool_update_lanes(&pool, first, &lanes, false, CAMERA_MODE_FREE, _out_matrices, _output);
+                    break;
+                case CAMERA_MODE_FIRST_PERSON:
+                    camera__pool_update_lanes(&pool, first, &lanes, false, CAMERA_MODE_FIRST_PERSON, _out_matrices, _output);
+                    break;
+                case CAMERA_MODE_ORBITAL:
+                    camera__pool_update_lanes(&pool, first, &lanes, false, CAMERA_MODE_ORBITAL, _out_matrices, _output);
+                    break;
+                default:
+                    camera__pool_update_lanes(&pool, first, &lanes, false, lanes.mode[0], _out_matrices, _output);
+                    break;
+                }
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                lanes.idle[i] = 0;
+                lanes.kernel[i] = 0;
+            }
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (lanes.idle[i] || lanes.kernel[i])
+            {
+                continue;
+            }
+
+            const uint32_t index = first + i;
+            const uint32_t camera_mode = _specialized ? _mode : pool.mode[index];
+            camera__pool_load_state(&pool, index, camera_mode, &cam);
+
+            const CameraVec3 movement = cm_init_vec3(lanes.movement_x[i], lanes.movement_y[i], lanes.movement_z[i]);
+            const CameraVec3 rotation = cm_init_vec3(lanes.rotation_x[i], lanes.rotation_y[i], lanes.rotation_z[i]);
+            float* matrix = _output != NULL ? NULL : _out_matrices + 16 * (size_t)index;
+            const bool settled = camera__update(&cam, camera_mode, movement, rotation, matrix, _output, index);
+            camera__pool_store_state(&pool, index, camera_mode, &cam);
+            camera__retain_dirty(&pool.dirty[index], settled);
+        }
+    }
+
+    if (_output != NULL)
+    {
+        camera__output_fence(_output);
+    }
+}
+
+extern void camera_pool_update(CameraPool* _pool, uint32_t _begin, uint32_t _end, float* _out_matrices)
+{
+    camera__pool_update(_pool, _begin, _end, _out_matrices, NULL, false, 0);
+}
+
+extern void camera_pool_update_output(CameraPool* _pool, uint32_t _begin, uint32_t _end, const CameraOutput* _output)
+{
+    camera__pool_update(_pool, _begin, _end, NULL, _output, false, 0);
+}
+
+#if defined(__cplusplus)
+template <uint32_t Mode> void camera_view_matrix(Camera* _cam, float* _out_matrix)
+{
+    camera__clear_dirty(&_cam->dirty);
+    const CameraVec3 movement = camera__drain(&_cam->movement_accumulator);
+    const CameraVec3 rotation = camera__drain(&_cam->rotation_accumulator);
+    const bool settled = camera__update(_cam, Mode, movement, rotation, _out_matrix, NULL, 0);
+    camera__retain_dirty(&_cam->dirty, settled);
+}
+
+template <uint32_t Mode> void camera_pool_update(CameraPool* _pool, uint32_t _begin, uint32_t _end, float* _out_matrices)
+{
+    camera__pool_update(_pool, _begin, _end, _out_matrices, NULL, true, Mode);
+}
+
+template <uint32_t Mode> void camera_view_matrix_batch(CameraPool* _pool, float* _out_matrices)
+{
+    camera_pool_update<Mode>(_pool, 0, _pool->count, _out_matrices);
+}
+
+#define CAMERA__INSTANTIATE_MODE(_mode) \
+    template void camera_view_matrix<(_mode)>(Camera* _cam, float* _out_matrix); \
+    template void camera_pool_update<(_mode)>(CameraPool* _pool, uint32_t _begin, uint32_t _end, float* _out_matrices); \
+    template void camera_view_matrix_batch<(_mode)>(CameraPool* _pool, float* _out_matrices);
+CAMERA_SPECIALIZED_MODES(CAMERA__INSTANTIATE_MODE)
+#undef CAMERA__INSTANTIATE_MODE
+#endif
+
+extern CameraProjection camera_projection_perspective(float _fov_y, float _aspect, float _near, float _far, uint32_t _flags)
+{
+    CameraProjection proj;
+    proj.flags = _flags & ~CAMERA_PROJECTION_ORTHOGRAPHIC;
+    proj.fov_y = _fov_y;
+    proj.height = 0.0f;
+    proj.aspect = _aspect;
+    proj.near_plane = _near;
+    proj.far_plane = _far;
+    return proj;
+}
+
+extern CameraProjection camera_projection_orthographic(float _height, float _aspect, float _near, float _far, uint32_t _flags)
+{
+    CameraProjection proj;
+    proj.flags = (_flags | CAMERA_PROJECTION_ORTHOGRAPHIC) & ~CAMERA_PROJECTION_INFINITE_FAR;
+    proj.fov_y = 0.0f;
+    proj.height = _height;
+    proj.aspect = _aspect;
+    proj.near_plane = _near;
+    proj.far_plane = _far;
+    return proj;
+}
+
+// The non-zero terms of a projection matrix
+//  Perspective:  x * sx, y * sy, z * sz + tz, w = z
+//  Orthographic: x * sx, y * sy, z * sz + tz, w = 1
+typedef struct camera__projection_terms {
+    float sx;
+    float sy;
+    float sz;
+    float tz;
+    bool perspective;
+} Camera__ProjectionTerms;
+
+static inline Camera__ProjectionTerms camera__projection_terms(const CameraProjection* _proj)
+{
+    Camera__ProjectionTerms terms;
+    terms.perspective = !(_proj->flags & CAMERA_PROJECTION_ORTHOGRAPHIC);
+
+    // Depth of the near and far plane after projection
+    float depthNear = (_proj->flags & CAMERA_PROJECTION_HOMOGENEOUS_DEPTH) ? -1.0f : 0.0f;
+    float depthFar = 1.0f;
+    if (_proj->flags & CAMERA_PROJECTION_REVERSED_Z)
+    {
+        const float tmp = depthNear;
+        depthNear = depthFar;
+        depthFar = tmp;
+    }
+
+    const float n = _proj->near_plane;
+    const float f = _proj->far_plane;
+
+    if (terms.perspective)
+    {
+        float sinHalfFov, cosHalfFov;
+        cm_sincos(_proj->fov_y * 0.5f, &sinHalfFov, &cosHalfFov);
+        CAMERA__PROFILE_COUNT(sincos, 1);
+
+        terms.sy = cosHalfFov / sinHalfFov;
+        terms.sx = terms.sy / _proj->aspect;
+
+        // Solve depth(z) = sz + tz / z for depth(n) = depthNear and depth(f) = depthFar
+        if (_proj->flags & CAMERA_PROJECTION_INFINITE_FAR)
+        {
+            terms.sz = depthFar;
+            terms.tz = (depthNear - depthFar) * n;
+        }
+        else
+        {
+            terms.tz = (depthNear - depthFar) * n * f / (f - n);
+            terms.sz = depthFar - terms.tz / f;
+        }
+    }
+    else
+    {
+        terms.sy = 2.0f / _proj->height;
+        terms.sx = terms.sy / _proj->aspect;
+
+        // Solve depth(z) = sz * z + tz for depth(n) = depthNear and depth(f) = depthFar
+        terms.sz = (depthFar - depthNear) / (f - n);
+        terms.tz = depthNear - terms.sz * n;
+    }
+
+    return terms;
+}
+
+static inline void camera__write_projection_matrix(const Camera__ProjectionTerms* _terms, float* _out_matrix)
+{
+    for (int i = 0; i < 16; ++i)
+    {
+        _out_matrix[i] = 0.0f;
+    }
+
+    _out_matrix[0] = _terms->sx;
+    _out_matrix[5] = _terms->sy;
+    _out_matrix[10] = _terms->sz;
+    _out_matrix[11] = _terms->perspective ? 1.0f : 0.0f;
+    _out_matrix[14] = _terms->tz;
+    _out_matrix[15] = _terms->perspective ? 0.0f : 1.0f;
+}
+
+extern void camera_projection_matrix(const CameraProjection* _proj, float* _out_matrix)
+{
+    const Camera__ProjectionTerms terms = camera__projection_terms(_proj);
+    camera__write_projection_matrix(&terms, _out_matrix);
+}
+
+// Write the view projection matrix from a view matrix and projection terms
+//  Only the non-zero projection terms are multiplied.
+static inline void camera__write_view_projection(const float* _view, const Camera__ProjectionTerms* _terms, float* _out_matrix)
+{
+    const float w2 = _terms->perspective ? 1.0f : 0.0f; // Weight of view z in clip w
+    const float w3 = _terms->perspective ? 0.0f : 1.0f; // Weight of 1 in clip w
+
+    for (int row = 0; row < 4; ++row)
+    {
+        const float* v = _view + 4 * row;
+        float* out = _out_matrix + 4 * row;
+        out[0] = v[0] * _terms->sx;
+        out[1] = v[1] * _terms->sy;
+        out[2] = v[2] * _terms->sz + v[3] * _terms->tz;
+        out[3] = v[2] * w2 + v[3] * w3;
+    }
+}
+
+// The non-zero terms of an inverse projection matrix
+//  Perspective:  (X, Y, Z, W) -> (X / sx, Y / sy, W, (Z - sz * W) / tz)
+//  Orthographic: (X, Y, Z, W) -> (X / sx, Y / sy, (Z - tz * W) / sz, W)
+//  Only rows 2 and 3 mix terms: row 2 = row2z * e2 + row2w * e3, row 3 = row3z * e2 + row3w * e3.
+typedef struct camera__inverse_projection_terms {
+    float isx;
+    float isy;
+    float row2z;
+    float row2w;
+    float row3z;
+    float row3w;
+} Camera__InverseProjectionTerms;
+
+static inline Camera__InverseProjectionTerms camera__inverse_projection_terms(const Camera__ProjectionTerms* _terms)
+{
+    Camera__InverseProjectionTerms inverse;
+    inverse.isx = 1.0f / _terms->sx;
+    inverse.isy = 1.0f / _terms->sy;
+
+    if (_terms->perspective)
+    {
+        const float itz = 1.0f / _terms->tz;
+        inverse.row2z = 0.0f;
+        inverse.row2w = itz;
+        inverse.row3z = 1.0f;
+        inverse.row3w = -_terms->sz * itz;
+    }
+    else
+    {
+        const float isz = 1.0f / _terms->sz;
+        inverse.row2z = isz;
+        inverse.row2w = 0.0f;
+        inverse.row3z = -_terms->tz * isz;
+        inverse.row3w = 1.0f;
+    }
+    return inverse;
+}
+
+extern void camera_matrices(Camera* _cam, const CameraProjection* _proj, CameraMatrices* _out)
+{
+    camera_view_matrix(_cam, _out->view);
+
+    const Camera__ProjectionTerms terms = camera__projection_terms(_proj);
+
+    camera__write_projection_matrix(&terms, _out->projection);
+    camera__write_view_projection(_out->view, &terms, _out->view_projection);
+
+    /* Inverse view */
+
+    // The rotation is orthonormal, so the inverse is its transpose followed by the eye translation
+    const CameraVec3 r = _cam->right;
+    const CameraVec3 u = _cam->up;
+    const CameraVec3 f = _cam->forward;
+    const CameraVec3 e = _cam->eye;
+
+    float* iv = _out->inverse_view;
+    iv[0] = r.x;  iv[1] = r.y;  iv[2] = r.z;   iv[3] = 0.0f;
+    iv[4] = u.x;  iv[5] = u.y;  iv[6] = u.z;   iv[7] = 0.0f;
+    iv[8] = f.x;  iv[9] = f.y;  iv[10] = f.z;  iv[11] = 0.0f;
+    iv[12] = e.x; iv[13] = e.y; iv[14] = e.z;  iv[15] = 1.0f;
+
+    /* Inverse projection */
+
+    const Camera__InverseProjectionTerms inverse = camera__inverse_projection_terms(&terms);
+    const float isx = inverse.isx;
+    const float isy = inverse.isy;
+    const float row2f = inverse.row2z; // Weights of (f, 0) and (e, 1)
+    const float row2e = inverse.row2w;
+    const float row3f = inverse.row3z;
+    const float row3e = inverse.row3w;
+
+    float* ip = _out->inverse_projection;
+    for (int i = 0; i < 16; ++i)
+    {
+        ip[i] = 0.0f;
+    }
+    ip[0] = isx;
+    ip[5] = isy;
+    ip[10] = row2f;
+    ip[11] = row2e;
+    ip[14] = row3f;
+    ip[15] = row3e;
+
+    /* Inverse view projection */
+
+    // inverse(view * projection) = inverse(projection) * inverse(view)
+    float* ivp = _out->inverse_view_projection;
+    ivp[0] = r.x * isx;  ivp[1] = r.y * isx;  ivp[2] = r.z * isx;  ivp[3] = 0.0f;
+    ivp[4] = u.x * isy;  ivp[5] = u.y * isy;  ivp[6] = u.z * isy;  ivp[7] = 0.0f;
+
+    ivp[8] = f.x * row2f + e.x * row2e;
+    ivp[9] = f.y * row2f + e.y * row2e;
+    ivp[10] = f.z * row2f + e.z * row2e;
+    ivp[11] = row2e;
+
+    ivp[12] = f.x * row3f + e.x * row3e;
+    ivp[13] = f.y * row3f + e.y * row3e;
+    ivp[14] = f.z * row3f + e.z * row3e;
+    ivp[15] = row3e;
+}
+
+extern CameraTemporal camera_temporal(uint32_t _jitter_length)
+{
+    CameraTemporal temporal;
+    temporal.jitter_length = _jitter_length;
+    temporal.frame = 0;
+    temporal.jitter[0] = 0.0f;
+    temporal.jitter[1] = 0.0f;
+    temporal.origin[0] = 0;
+    temporal.origin[1] = 0;
+    temporal.origin[2] = 0;
+    temporal.projection = camera_projection_perspective(1.0f, 1.0f, 1.0f, 2.0f, 0);
+    temporal.previous_projection = temporal.projection;
+    for (int i = 0; i < 16; ++i)
+    {
+        const float identity = (i % 5 == 0) ? 1.0f : 0.0f;
+        temporal.view[i] = identity;
+        temporal.previous_view[i] = identity;
+        temporal.view_projection[i] = identity;
+        temporal.previous_view_projection[i] = identity;
+        temporal.jittered_projection[i] = identity;
+        temporal.jittered_view_projection[i] = identity;
+        temporal.reprojection[i] = identity;
+    }
+    return temporal;
+}
+
+extern float camera_halton(uint32_t _index, uint32_t _base)
+{
+    const float inverseBase = 1.0f / (float)_base;
+    float scale = inverseBase;
+    float result = 0.0f;
+    while (_index > 0)
+    {
+        result += (float)(_index % _base) * scale;
+        _index /= _base;
+        scale *= inverseBase;
+    }
+    return result;
+}
+
+extern void camera_temporal_matrices(Camera* _cam, const CameraProjection* _proj, uint32_t _width, uint32_t _height, CameraTemporal* _temporal)
+{
+    CameraTemporal* t = _temporal;
+    const bool first = t->frame == 0;
+
+    /* Retain the previous frame */
+
+    for (int i = 0; i < 16; ++i)
+    {
+        t->previous_view[i] = t->view[i];
+        t->previous_view_projection[i] = t->view_projection[i];
+    }
+    t->previous_projection = t->projection;
+    t->projection = *_proj;
+
+    camera_view_matrix(_cam, t->view);
+
+    // Move the previous matrices onto the current origin: a point p relative to it was p + shift relative to the previous one
+    if (!first && (t->origin[0] != _cam->origin[0] || t->origin[1] != _cam->origin[1] || t->origin[2] != _cam->origin[2]))
+    {
+        const float shift[3] = {
+            (float)(_cam->origin[0] - t->origin[0]) * CAMERA_ORIGIN_CELL_SIZE,
+            (float)(_cam->origin[1] - t->origin[1]) * CAMERA_ORIGIN_CELL_SIZE,
+            (float)(_cam->origin[2] - t->origin[2]) * CAMERA_ORIGIN_CELL_SIZE,
+        };
+        for (int col = 0; col < 4; ++col)
+        {
+            t->previous_view[12 + col] += shift[0] * t->previous_view[col] + shift[1] * t->previous_view[4 + col] + shift[2] * t->previous_view[8 + col];
+            t->previous_view_projection[12 + col] += shift[0] * t->previous_view_projection[col]
+                + shift[1] * t->previous_view_projection[4 + col] + shift[2] * t->previous_view_projection[8 + col];
+        }
+    }
+    t->origin[0] = _cam->origin[0];
+    t->origin[1] = _cam->origin[1];
+    t->origin[2] = _cam->origin[2];
+
+    const Camera__ProjectionTerms terms = camera__projection_terms(_proj);
+    camera__write_view_projection(t->view, &terms, t->view_projection);
+
+    if (first)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            t->previous_view[i] = t->view[i];
+            t->previous_view_projection[i] = t->view_projection[i];
+        }
+        t->previous_projection = t->projection;
+    }
+
+    /* Jitter */
+
+    // Halton (2, 3) starting at element 1, element 0 is the unjittered center
+    float jx = 0.0f;
+    float jy = 0.0f;
+    if (t->jitter_length > 0)
+    {
+        const uint32_t index = t->frame % t->jitter_length + 1;
+        t->jitter[0] = camera_halton(index, 2) - 0.5f;
+        t->jitter[1] = camera_halton(index, 3) - 0.5f;
+        jx = 2.0f * t->jitter[0] / (float)_width;  // In clip space, where the render target is 2 wide
+        jy = 2.0f * t->jitter[1] / (float)_height;
+    }
+
+    // clip.xy += jitter * clip.w, clip.w is view z (perspective) or 1 (orthographic)
+    camera__write_projection_matrix(&terms, t->jittered_projection);
+    const int jitterRow = terms.perspective ? 8 : 12;
+    t->jittered_projection[jitterRow + 0] += jx;
+    t->jittered_projection[jitterRow + 1] += jy;
+
+    for (int row = 0; row < 4; ++row)
+    {
+        const float* vp = t->view_projection + 4 * row;
+        float* out = t->jittered_view_projection + 4 * row;
+        out[0] = vp[0] + jx * vp[3];
+        out[1] = vp[1] + jy * vp[3];
+        out[2] = vp[2];
+        out[3] = vp[3];
+    }
+
+    /* Reprojection */
+
+    // reprojection = inverse(projection) * inverse(view) * previous_view * previous_projection
+    //  inverse(view) * previous_view is rigid: rotation B^T * B' (B = the 3x3 rotation of the view), translation t' - t * B^T * B'
+    const float* v = t->view;
+    const float* pv = t->previous_view;
+    float rigid[16];
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 3; ++col)
+        {
+            // Row 'row' of B^T is column 'row' of B
+            rigid[4 * row + col] = v[row] * pv[col] + v[4 + row] * pv[4 + col] + v[8 + row] * pv[8 + col];
+        }
+        rigid[4 * row + 3] = 0.0f;
+    }
+    for (int col = 0; col < 3; ++col)
+    {
+        rigid[12 + col] = pv[12 + col] - (v[12] * rigid[col] + v[13] * rigid[4 + col] + v[14] * rigid[8 + col]);
+    }
+    rigid[15] = 1.0f;
+
+    const Camera__ProjectionTerms previousTerms = camera__projection_terms(&t->previous_projection);
+    float projected[16];
+    camera__write_view_projection(rigid, &previousTerms, projected);
+
+    const Camera__InverseProjectionTerms inverse = camera__inverse_projection_terms(&terms);
+    float* r = t->reprojection;
+    for (int col = 0; col < 4; ++col)
+    {
+        r[col] = projected[col] * inverse.isx;
+        r[4 + col] = projected[4 + col] * inverse.isy;
+        r[8 + col] = projected[8 + col] * inverse.row2z + projected[12 + col] * inverse.row2w;
+        r[12 + col] = projected[8 + col] * inverse.row3z + projected[12 + col] * inverse.row3w;
+    }
+
+    t->frame++;
+}
+
+extern CameraFrustum camera_frustum(const float* _view_projection, uint32_t _projection_flags)
+{
+    // Gribb/Hartmann: clip = p * view_projection, so column j of the matrix yields clip component j
+    const float* m = _view_projection;
+    const float cx[4] = { m[0], m[4], m[8], m[12] };
+    const float cy[4] = { m[1], m[5], m[9], m[13] };
+    const float cz[4] = { m[2], m[6], m[10], m[14] };
+    const float cw[4] = { m[3], m[7], m[11], m[15] };
+
+    // Lower depth bound of the clip volume is z >= 0 or z >= -w, the upper bound is always z <= w
+    const float lowerW = (_projection_flags & CAMERA_PROJECTION_HOMOGENEOUS_DEPTH) ? 1.0f : 0.0f;
+    const int lowerPlane = (_projection_flags & CAMERA_PROJECTION_REVERSED_Z) ? CAMERA_FRUSTUM_FAR : CAMERA_FRUSTUM_NEAR;
+    const int upperPlane = (_projection_flags & CAMERA_PROJECTION_REVERSED_Z) ? CAMERA_FRUSTUM_NEAR : CAMERA_FRUSTUM_FAR;
+
+    CameraFrustum frustum;
+    for (int i = 0; i < 4; ++i)
+    {
+        frustum.planes[CAMERA_FRUSTUM_LEFT][i] = cw[i] + cx[i];
+        frustum.planes[CAMERA_FRUSTUM_RIGHT][i] = cw[i] - cx[i];
+        frustum.planes[CAMERA_FRUSTUM_BOTTOM][i] = cw[i] + cy[i];
+        frustum.planes[CAMERA_FRUSTUM_TOP][i] = cw[i] - cy[i];
+        frustum.planes[lowerPlane][i] = cw[i] * lowerW + cz[i];
+        frustum.planes[upperPlane][i] = cw[i] - cz[i];
+    }
+
+    for (int p = 0; p < CAMERA_FRUSTUM_PLANES; ++p)
+    {
+        float* plane = frustum.planes[p];
+        const float lengthSq = plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2];
+
+        if (lengthSq > 1e-12f)
+        {
+            const float invLength = 1.0f / cm_sqrt(lengthSq);
+            plane[0] *= invLength;
+            plane[1] *= invLength;
+            plane[2] *= invLength;
+            plane[3] *= invLength;
+        }
+        else
+        { // Degenerated plane (ex. infinite far plane)
+            plane[0] = 0.0f;
+            plane[1] = 0.0f;
+            plane[2] = 0.0f;
+            plane[3] = 1.0f;
+        }
+    }
+
+    return frustum;
+}
+
+// Number of objects tested together by the branch-free culling paths (one output word)
+#define CAMERA__CULL_BLOCK 32
+
+static inline float camera__abs(float _a)
+{
+    return _a < 0.0f ? -_a : _a;
+}
+
+// Signed distance of a bounding volume to a plane, negative if completely outside
+static inline float camera__sphere_distance(const float* _plane, float _x, float _y, float _z, float _radius)
+{
+    return _plane[0] * _x + _plane[1] * _y + _plane[2] * _z + _plane[3] + _radius;
+}
+
+static inline float camera__aabb_distance(const float* _plane, float _x, float _y, float _z, float _ex, float _ey, float _ez)
+{
+    // Projected radius of the box onto the plane normal
+    const float radius = camera__abs(_plane[0]) * _ex + camera__abs(_plane[1]) * _ey + camera__abs(_plane[2]) * _ez;
+    return _plane[0] * _x + _plane[1] * _y + _plane[2] * _z + _plane[3] + radius;
+}
+
+static inline uint32_t camera__cull_pack(const float* _distance, uint32_t _count)
+{
+    uint32_t bits = 0;
+    for (uint32_t j = 0; j < _count; ++j)
+    {
+        bits |= (uint32_t)(_distance[j] >= 0.0f) << j;
+    }
+    return bits;
+}
+
+extern void camera_cull_spheres(const CameraFrustum* _frustum, const float* _x, const float* _y, const float* _z, const float* _radius, uint32_t _count, uint32_t* _out_visible, uint8_t* _last_plane)
+{
+    for (uint32_t block = 0; block < _count; block += CAMERA__CULL_BLOCK)
+    {
+        const uint32_t n = (_count - block < CAMERA__CULL_BLOCK) ? _count - block : CAMERA__CULL_BLOCK;
+        uint32_t bits = 0;
+
+        if (_last_plane)
+        {
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                const uint32_t i = block + j;
+                const int first = _last_plane[i] % CAMERA_FRUSTUM_PLANES;
+                bool visible = camera__sphere_distance(_frustum->planes[first], _x[i], _y[i], _z[i], _radius[i]) >= 0.0f;
+
+                for (int p = 0; visible && p < CAMERA_FRUSTUM_PLANES; ++p)
+                {
+                    if (p != first && camera__sphere_distance(_frustum->planes[p], _x[i], _y[i], _z[i], _radius[i]) < 0.0f)
+                    {
+                        visible = false;
+                        _last_plane[i] = (uint8_t)p;
+                    }
+                }
+
+                bits |= (uint32_t)visible << j;
+            }
+        }
+        else
+        {
+            // Minimum signed distance over all planes, each plane loop is independent per sphere
+            float distance[CAMERA__CULL_BLOCK];
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                distance[j] = camera__sphere_distance(_frustum->planes[0], _x[block + j], _y[block + j], _z[block + j], _radius[block + j]);
+            }
+
+            for (int p = 1; p < CAMERA_FRUSTUM_PLANES; ++p)
+            {
+                for (uint32_t j = 0; j < n; ++j)
+                {
+                    distance[j] = cm_min(distance[j], camera__sphere_distance(_frustum->planes[p], _x[block + j], _y[block + j], _z[block + j], _radius[block + j]));
+                }
+            }
+
+            bits = camera__cull_pack(distance, n);
+        }
+
+        _out_visible[block / CAMERA__CULL_BLOCK] = bits;
+    }
+}
+
+extern void camera_cull_aabbs(const CameraFrustum* _frustum, const float* _x, const float* _y, const float* _z, const float* _ex, const float* _ey, const float* _ez, uint32_t _count, uint32_t* _out_visible, uint8_t* _last_plane)
+{
+    for (uint32_t block = 0; block < _count; block += CAMERA__CULL_BLOCK)
+    {
+        const uint32_t n = (_count - block < CAMERA__CULL_BLOCK) ? _count - block : CAMERA__CULL_BLOCK;
+        uint32_t bits = 0;
+
+        if (_last_plane)
+        {
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                const uint32_t i = block + j;
+                const int first = _last_plane[i] % CAMERA_FRUSTUM_PLANES;
+                bool visible = camera__aabb_distance(_frustum->planes[first], _x[i], _y[i], _z[i], _ex[i], _ey[i], _ez[i]) >= 0.0f;
+
+                for (int p = 0; visible && p < CAMERA_FRUSTUM_PLANES; ++p)
+                {
+                    if (p != first && camera__aabb_distance(_frustum->planes[p], _x[i], _y[i], _z[i], _ex[i], _ey[i], _ez[i]) < 0.0f)
+                    {
+                        visible = false;
+                        _last_plane[i] = (uint8_t)p;
+                    }
+                }
+
+                bits |= (uint32_t)visible << j;
+            }
+        }
+        else
+        {
+            float distance[CAMERA__CULL_BLOCK];
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                const uint32_t i = block + j;
+                distance[j] = camera__aabb_distance(_frustum->planes[0], _x[i], _y[i], _z[i], _ex[i], _ey[i], _ez[i]);
+            }
+
+            for (int p = 1; p < CAMERA_FRUSTUM_PLANES; ++p)
+            {
+                for (uint32_t j = 0; j < n; ++j)
+                {
+                    const uint32_t i = block + j;
+                    distance[j] = cm_min(distance[j], camera__aabb_distance(_frustum->planes[p], _x[i], _y[i], _z[i], _ex[i], _ey[i], _ez[i]));
+                }
+            }
+
+            bits = camera__cull_pack(distance, n);
+        }
+
+        _out_visible[block / CAMERA__CULL_BLOCK] = bits;
+    }
+}
+
+extern CameraLod camera_lod(const float* _pixel_radius, uint32_t _count, float _hysteresis)
+{
+    CameraLod lod;
+    lod.count = _count < 1 ? 1 : (_count > CAMERA_LOD_LEVELS ? CAMERA_LOD_LEVELS : _count);
+    lod.hysteresis = _hysteresis;
+    for (uint32_t i = 0; i < CAMERA_LOD_LEVELS - 1; ++i)
+    {
+        lod.pixel_radius[i] = i + 1 < lod.count ? _pixel_radius[i] : 0.0f;
+    }
+    return lod;
+}
+
+extern void camera_lod_select(const Camera* _cam, const CameraProjection* _proj, float _viewport_height, const CameraLod* _lod,
+    const float* _x, const float* _y, const float* _z, const float* _radius, uint32_t _count,
+    float* _out_distance_sq, float* _out_pixel_radius, uint8_t* _levels)
+{
+    const CameraVec3 eye = _cam->eye;
+    const bool perspective = (_proj->flags & CAMERA_PROJECTION_ORTHOGRAPHIC) == 0;
+
+    // Pixels per world unit at distance 1 (perspective) or everywhere (orthographic)
+    float scale;
+    if (perspective)
+    {
+        float s, c;
+        cm_sincos(0.5f * _proj->fov_y, &s, &c);
+        CAMERA__PROFILE_COUNT(sincos, 1);
+        scale = 0.5f * _viewport_height * c / s;
+    }
+    else
+    {
+        scale = _viewport_height / _proj->height;
+    }
+
+    // Thresholds to leave a level towards the coarser (shrink) or finer (grow) side
+    //  The count is clamped again, as the members of a CameraLod may be written directly.
+    const uint32_t count = _lod->count < 1 ? 1 : (_lod->count > CAMERA_LOD_LEVELS ? CAMERA_LOD_LEVELS : _lod->count);
+    const uint32_t thresholds = count - 1;
+    float shrink[CAMERA_LOD_LEVELS - 1];
+    float grow[CAMERA_LOD_LEVELS - 1];
+    for (uint32_t t = 0; t < thresholds; ++t)
+    {
+        shrink[t] = _lod->pixel_radius[t] * (1.0f - _lod->hysteresis);
+        grow[t] = _lod->pixel_radius[t] * (1.0f + _lod->hysteresis);
+    }
+
+    for (uint32_t block = 0; block < _count; block += CAMERA__CULL_BLOCK)
+    {
+        const uint32_t n = (_count - block < CAMERA__CULL_BLOCK) ? _count - block : CAMERA__CULL_BLOCK;
+
+        // Each loop is independent per sphere
+        float distanceSq[CAMERA__CULL_BLOCK];
+        float pixels[CAMERA__CULL_BLOCK];
+        for (uint32_t j = 0; j < n; ++j)
+        {
+            const uint32_t i = block + j;
+            const float dx = _x[i] - eye.x;
+            const float dy = _y[i] - eye.y;
+            const float dz = _z[i] - eye.z;
+            distanceSq[j] = dx * dx + dy * dy + dz * dz;
+        }
+
+        if (perspective)
+        {
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                const float radius = _radius[block + j];
+                pixels[j] = radius * scale / cm_sqrt(cm_max(distanceSq[j], radius * radius));
+            }
+        }
+        else
+        {
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                pixels[j] = _radius[block + j] * scale;
+            }
+        }
+
+        // The level is the number of thresholds above the radius
+        //  A threshold below the previous level (t >= previous) is only crossed once the radius shrank below shrink[t],
+        //  a threshold above it only once the radius grew above grow[t].
+        uint32_t previous[CAMERA__CULL_BLOCK];
+        uint32_t levels[CAMERA__CULL_BLOCK];
+        for (uint32_t j = 0; j < n; ++j)
+        {
+            previous[j] = _levels[block + j];
+            levels[j] = 0;
+        }
+
+        for (uint32_t t = 0; t < thresholds; ++t)
+        {
+            const float growT = grow[t];
+            const float shrinkT = shrink[t];
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                const float threshold = t < previous[j] ? growT : shrinkT;
+                levels[j] += (uint32_t)(pixels[j] < threshold);
+            }
+        }
+
+        for (uint32_t j = 0; j < n; ++j)
+        {
+            _levels[block + j] = (uint8_t)levels[j];
+        }
+
+        if (_out_distance_sq)
+        {
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                _out_distance_sq[block + j] = distanceSq[j];
+            }
+        }
+        if (_out_pixel_radius)
+        {
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                _out_pixel_radius[block + j] = pixels[j];
+            }
+        }
+    }
+}
+
+extern void camera_stereo_views(const Camera* _cam, float _ipd, float* _out_matrices)
+{
+    float* left = _out_matrices;
+    float* right = _out_matrices + 16;
+
+    camera__write_view_matrix(_cam, left, NULL, 0);
+    for (int i = 0; i < 16; ++i)
+    {
+        right[i] = left[i];
+    }
+
+    // Both eyes share the rotation. Moving the eye along right only changes -dot(right, eye).
+    left[12] += 0.5f * _ipd;
+    right[12] -= 0.5f * _ipd;
+}
+
+// Right, up and forward of every cube map face
+static const float camera__cube_bases[CAMERA_CUBE_FACES][9] = {
+    {  0.0f, 0.0f, -1.0f,   0.0f, 1.0f,  0.0f,   1.0f,  0.0f,  0.0f }, // +X
+    {  0.0f, 0.0f,  1.0f,   0.0f, 1.0f,  0.0f,  -1.0f,  0.0f,  0.0f }, // -X
+    {  1.0f, 0.0f,  0.0f,   0.0f, 0.0f, -1.0f,   0.0f,  1.0f,  0.0f }, // +Y
+    {  1.0f, 0.0f,  0.0f,   0.0f, 0.0f,  1.0f,   0.0f, -1.0f,  0.0f }, // -Y
+    {  1.0f, 0.0f,  0.0f,   0.0f, 1.0f,  0.0f,   0.0f,  0.0f,  1.0f }, // +Z
+    { -1.0f, 0.0f,  0.0f,   0.0f, 1.0f,  0.0f,   0.0f,  0.0f, -1.0f }, // -Z
+};
+
+extern void camera_cube_views(const Camera* _cam, float* _out_matrices)
+{
+    for (int face = 0; face < CAMERA_CUBE_FACES; ++face)
+    {
+        const float* b = camera__cube_bases[face];
+        camera__write_view(cm_init_vec3(b[0], b[1], b[2]), cm_init_vec3(b[3], b[4], b[5]), cm_init_vec3(b[6], b[7], b[8]),
+            _cam->eye, _out_matrices + 16 * face);
+    }
+}
+
+// Round _value down to a multiple of _step
+static inline float camera__snap(float _value, float _step)
+{
+    const float steps = _value / _step;
+    float whole = (float)(int64_t)steps;
+    whole = whole > steps ? whole - 1.0f : whole;
+    return whole * _step;
+}
+
+extern void camera_cascade_views(const Camera* _cam, const CameraProjection* _proj, CameraVec3 _light_direction,
+    const float* _splits, uint32_t _cascade_count, uint32_t _resolution, float* _out_matrices, CameraProjection* _out_projections)
+{
+    // Half width and height of the view volume, per unit of depth for perspective projections
+    const bool perspective = !(_proj->flags & CAMERA_PROJECTION_ORTHOGRAPHIC);
+    float halfHeight = 0.5f * _proj->height;
+    if (perspective)
+    {
+        float sinHalfFov, cosHalfFov;
+        cm_sincos(_proj->fov_y * 0.5f, &sinHalfFov, &cosHalfFov);
+        CAMERA__PROFILE_COUNT(sincos, 1);
+        halfHeight = sinHalfFov / cosHalfFov;
+    }
+    const float halfWidth = halfHeight * _proj->aspect;
+    const float extent2 = halfWidth * halfWidth + halfHeight * halfHeight;
+
+    // Light basis, shared by all cascades
+    const CameraVec3 forward = _light_direction;
+    const CameraVec3 worldUp = CAMERA_WORLD_UP;
+    const bool vertical = cm_dot(forward, worldUp) > 0.99f || cm_dot(forward, worldUp) < -0.99f;
+    const CameraVec3 right = cm_normalizeVec3(cm_cross(vertical ? CAMERA_WORLD_FORWARD : worldUp, forward));
+    const CameraVec3 up = cm_cross(forward, right);
+
+    const uint32_t depthFlags = _proj->flags & (CAMERA_PROJECTION_REVERSED_Z | CAMERA_PROJECTION_HOMOGENEOUS_DEPTH);
+
+    for (uint32_t i = 0; i < _cascade_count; ++i)
+    {
+        const float n = _splits[i];
+        const float f = _splits[i + 1];
+
+        // Bounding sphere of the view volume between depth n and f, centered on the view axis at depth
+        //  Perspective: equidistant to the near and far corners, but never behind the far plane
+        float depth, radius;
+        if (perspective)
+        {
+            depth = cm_min(0.5f * (n + f) * (1.0f + extent2), f);
+            radius = cm_sqrt((f - depth) * (f - depth) + f * f * extent2);
+        }
+        else
+        {
+            depth = 0.5f * (n + f);
+            radius = cm_sqrt(0.25f * (f - n) * (f - n) + extent2);
+        }
+
+        const CameraVec3 center = cm_add(_cam->eye, cm_scale(_cam->forward, depth));
+
+        // Snapping moves the center by up to one texel, the size grows by one texel on each side to keep the sphere covered
+        float size = 2.0f * radius;
+        if (_resolution > 2)
+        {
+            size *= (float)_resolution / (float)(_resolution - 2);
+        }
+
+        float* out = _out_matrices + 16 * i;
+        camera__write_view(right, up, forward, center, out);
+
+        if (_resolution > 2)
+        {
+            const float texel = size / (float)_resolution;
+            out[12] = camera__snap(out[12], texel);
+            out[13] = camera__snap(out[13], texel);
+        }
+
+        _out_projections[i] = camera_projection_orthographic(size, 1.0f, -radius, radius, depthFlags);
+    }
+}
+
+#if defined(CAMERA_PROFILE)
+extern CameraProfileCounters* camera_profile_counters(void)
+{
+    return &camera__profile;
+}
+
+extern void camera_profile_reset(void)
+{
+    static CameraProfileCounters zero; // Zero initialized
+    camera__profile = zero;
+}
+#endif
+
+// Packed layout, two little endian 64 bit words:
+//  word 0: position x (21 bits) | position y (21 bits) | position z (21 bits) | unused (1 bit)
+//  word 1: distance (16 bits) | largest quaternion component (2 bits) | 3x smallest components (15 bits each) | unused (1 bit)
+#define CAMERA__PACKED_POSITION_BITS        21
+#define CAMERA__PACKED_POSITION_BIAS        ((1u << (CAMERA__PACKED_POSITION_BITS - 1)) - 1) // Offset binary, symmetric range
+#define CAMERA__PACKED_DISTANCE_BITS        16
+#define CAMERA__PACKED_DISTANCE_BIAS        ((1u << (CAMERA__PACKED_DISTANCE_BITS - 1)) - 1) // Offset binary, symmetric range
+#define CAMERA__PACKED_QUAT_BITS            15
+#define CAMERA__PACKED_QUAT_MAX             ((1u << CAMERA__PACKED_QUAT_BITS) - 1)
+
+// Quantize _value in [0; _max] (clamped) to the nearest integer
+static inline uint32_t camera__quantize(float _value, uint32_t _max)
+{
+    const float value = cm_min(cm_max(_value + 0.5f, 0.0f), (float)_max);
+    return (uint32_t)value;
+}
+
+// Quantize _value in [-_bias; _bias] (clamped) to the nearest integer, returned in offset binary
+//  Rounding before adding the bias keeps the full float precision of small values.
+static inline uint32_t camera__quantize_signed(float _value, uint32_t _bias)
+{
+    const float value = cm_min(cm_max(_value, -(float)_bias), (float)_bias);
+    const int32_t steps = (int32_t)(value + (value < 0.0f ? -0.5f : 0.5f));
+    return (uint32_t)(steps + (int32_t)_bias);
+}
+
+static inline void camera__store_u64(uint8_t* _out, uint64_t _value)
+{
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        _out[i] = (uint8_t)(_value >> (8 * i));
+    }
+}
+
+static inline uint64_t camera__load_u64(const uint8_t* _in)
+{
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        value |= (uint64_t)_in[i] << (8 * i);
+    }
+    return value;
+}
+
+static inline CameraPacked camera__pack(CameraVec3 _position, float _distance, CameraQuat _orientation, const CameraPacking* _packing)
+{
+    /* Position and distance */
+
+    const float toSteps = _packing->position_step > 0.0f ? 1.0f / _packing->position_step : 0.0f;
+
+    const uint64_t px = camera__quantize_signed(_position.x * toSteps, CAMERA__PACKED_POSITION_BIAS);
+    const uint64_t py = camera__quantize_signed(_position.y * toSteps, CAMERA__PACKED_POSITION_BIAS);
+    const uint64_t pz = camera__quantize_signed(_position.z * toSteps, CAMERA__PACKED_POSITION_BIAS);
+
+    const float distanceScale = _packing->max_distance > 0.0f ? (float)CAMERA__PACKED_DISTANCE_BIAS / _packing->max_distance : 0.0f;
+    const uint64_t distance = camera__quantize_signed(_distance * distanceScale, CAMERA__PACKED_DISTANCE_BIAS);
+
+
+    /* Orientation (smallest three) */
+
+    // The largest component is dropped and rebuilt from unit length.
+    //  q and -q are the same orientation, so flip q to make it positive.
+    float q[4] = { _orientation.x, _orientation.y, _orientation.z, _orientation.w };
+    const float norm = cm_sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        if (q[i] * q[i] > q[largest] * q[largest])
+        {
+            largest = i;
+        }
+    }
+
+    // The other components are within [-1/sqrt(2); 1/sqrt(2)]
+    const float sqrt2 = 1.41421356f;
+    const float scale = (q[largest] < 0.0f ? -1.0f : 1.0f) * (norm > 0.0f ? 1.0f / norm : 0.0f);
+
+    uint64_t orientation = largest;
+    uint32_t shift = 2;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i != largest)
+        {
+            const float component = q[i] * scale * sqrt2 * 0.5f + 0.5f; // [0; 1]
+            orientation |= (uint64_t)camera__quantize(component * (float)CAMERA__PACKED_QUAT_MAX, CAMERA__PACKED_QUAT_MAX) << shift;
+            shift += CAMERA__PACKED_QUAT_BITS;
+        }
+    }
+
+
+    CameraPacked packed;
+    camera__store_u64(packed.data, px | (py << CAMERA__PACKED_POSITION_BITS) | (pz << (2 * CAMERA__PACKED_POSITION_BITS)));
+    camera__store_u64(packed.data + 8, distance | (orientation << CAMERA__PACKED_DISTANCE_BITS));
+    return packed;
+}
+
+static inline void camera__unpack(const CameraPacked* _packed, const CameraPacking* _packing, CameraVec3* _position, float* _distance, CameraQuat* _orientation)
+{
+    const uint64_t word0 = camera__load_u64(_packed->data);
+    const uint64_t word1 = camera__load_u64(_packed->data + 8);
+
+    /* Position and distance */
+
+    const uint64_t positionMask = (1u << CAMERA__PACKED_POSITION_BITS) - 1;
+    const int32_t bias = (int32_t)CAMERA__PACKED_POSITION_BIAS;
+
+    *_position = cm_init_vec3(
+        (float)((int32_t)(word0 & positionMask) - bias) * _packing->position_step,
+        (float)((int32_t)((word0 >> CAMERA__PACKED_POSITION_BITS) & positionMask) - bias) * _packing->position_step,
+        (float)((int32_t)((word0 >> (2 * CAMERA__PACKED_POSITION_BITS)) & positionMask) - bias) * _packing->position_step
+    );
+
+    const uint64_t distanceMask = (1u << CAMERA__PACKED_DISTANCE_BITS) - 1;
+    const int32_t distanceBias = (int32_t)CAMERA__PACKED_DISTANCE_BIAS;
+    *_distance = (float)((int32_t)(word1 & distanceMask) - distanceBias) * (_packing->max_distance / (float)CAMERA__PACKED_DISTANCE_BIAS);
+
+
+    /* Orientation (smallest three) */
+
+    const uint64_t orientation = word1 >> CAMERA__PACKED_DISTANCE_BITS;
+    const uint32_t largest = (uint32_t)(orientation & 3);
+    const float sqrt2 = 1.41421356f;
+
+    float q[4];
+    float sum = 0.0f;
+    uint32_t shift = 2;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i != largest)
+        {
+            const float component = (float)((orientation >> shift) & CAMERA__PACKED_QUAT_MAX) / (float)CAMERA__PACKED_QUAT_MAX; // [0; 1]
+            q[i] = (component - 0.5f) * 2.0f / sqrt2;
+            sum += q[i] * q[i];
+            shift += CAMERA__PACKED_QUAT_BITS;
+        }
+    }
+    q[largest] = cm_sqrt(cm_max(1.0f - sum, 0.0f));
+
+    *_orientation = cm_normalizeQuat(cm_init_quat(q[0], q[1], q[2], q[3]));
+}
+
+extern CameraPacking camera_packing(float _position_step, float _max_distance)
+{
+    CameraPacking packing;
+    packing.position_step = _position_step;
+    packing.max_distance = _max_distance;
+    return packing;
+}
+
+extern CameraPacked camera_pack(const Camera* _cam, const CameraPacking* _packing)
+{
+    return camera__pack(_cam->target_position, _cam->target_distance, _cam->orientation, _packing);
+}
+
+extern void camera_unpack(const CameraPacked* _packed, const CameraPacking* _packing, Camera* _cam)
+{
+    CameraVec3 position;
+    float distance;
+    CameraQuat orientation;
+    camera__unpack(_packed, _packing, &position, &distance, &orientation);
+
+    // Repeated packets of a camera at rest leave it clean
+    if (position.x != _cam->target_position.x || position.y != _cam->target_position.y || position.z != _cam->target_position.z
+        || distance != _cam->target_distance
+        || orientation.x != _cam->orientation.x || orientation.y != _cam->orientation.y
+        || orientation.z != _cam->orientation.z || orientation.w != _cam->orientation.w)
+    {
+        _cam->target_position = position;
+        _cam->target_distance = distance;
+        _cam->orientation = orientation;
+        camera_mark_dirty(_cam);
+    }
+}
+
+extern void camera_pool_pack(const CameraPool* _pool, const uint32_t* _indices, uint32_t _count, const CameraPacking* _packing, CameraPacked* _out)
+{
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+        const uint32_t index = _indices != NULL ? _indices[i] : i;
+
+        const CameraVec3 position = cm_init_vec3(_pool->target_position_x[index], _pool->target_position_y[index], _pool->target_position_z[index]);
+        const CameraQuat orientation = cm_init_quat(_pool->orientation_x[index], _pool->orientation_y[index], _pool->orientation_z[index], _pool->orientation_w[index]);
+        _out[i] = camera__pack(position, _pool->target_distance[index], orientation, _packing);
+    }
+}
+
+extern void camera_pool_unpack(const CameraPacked* _packed, const uint32_t* _indices, uint32_t _count, const CameraPacking* _packing, CameraPool* _pool)
+{
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+        const uint32_t index = _indices != NULL ? _indices[i] : i;
+
+        CameraVec3 position;
+        float distance;
+        CameraQuat orientation;
+        camera__unpack(&_packed[i], _packing, &position, &distance, &orientation);
+
+        if (position.x != _pool->target_position_x[index] || position.y != _pool->target_position_y[index] || position.z != _pool->target_position_z[index]
+            || distance != _pool->target_distance[index]
+            || orientation.x != _pool->orientation_x[index] || orientation.y != _pool->orientation_y[index]
+            || orientation.z != _pool->orientation_z[index] || orientation.w != _pool->orientation_w[index])
+        {
+            _pool->target_position_x[index] = position.x;
+            _pool->target_position_y[index] = position.y;
+            _pool->target_position_z[index] = position.z;
+            _pool->target_distance[index] = distance;
+            _pool->orientation_x[index] = orientation.x;
+            _pool->orientation_y[index] = orientation.y;
+            _pool->orientation_z[index] = orientation.z;
+            _pool->orientation_w[index] = orientation.w;
+            camera_pool_mark_dirty(_pool, index);
+        }
+    }
 }
 
 #endif // CAMERA_IMPLEMENTATION
@@ -0,0 +1,709 @@
+/*
+ * INFO:
+ *
+ *  This file provides interest management for servers running one camera per connected player:
+ *   "which cameras can see this point / AABB" and "which entities does camera k see",
+ *   without testing every entity against every frustum.
+ *
+ *  The world is divided into cubic cells of cell_size, hashed into a fixed number of buckets.
+ *   - Every bucket holds a bitset of the cameras whose frustum bounds overlap one of its cells.
+ *     A camera is only re-inserted once its generation or its pose changed, idle players cost a few compares per update.
+ *     The pose catches slots taken over by another camera of the same generation (ex. after camera_pool_remove(..)).
+ *   - Entities are sorted into the buckets of their cells once per camera_interest_entities(..) call (counting sort).
+ *  Queries only visit the buckets around the queried volume and test the candidates against the exact frustum.
+ *   Hash collisions only add candidates, they never change the result.
+ *
+ *  Cameras whose frustum spans more cells than there are buckets (ex. CAMERA_PROJECTION_INFINITE_FAR)
+ *   are kept in a separate set, which is a candidate of every query.
+ *
+ *
+ * USAGE:
+ *
+ *  Include 'camera.h' first. ONE (and only ONE) source file must hold the implementation
+ *   by using '#define CAMERA_INTEREST_IMPLEMENTATION' before including 'camera_interest.h'.
+ *
+ *  The index does not allocate. Query camera_interest_memory_size(..) and pass aligned memory to camera_interest_init(..).
+ *
+ *  Example:
+ *   1. 'CameraInterest interest = camera_interest_init(memory, 64, 4096, 1024, 32.0f);'
+ *   2. Every tick, after the cameras were updated:
+ *       'camera_interest_update(&interest, players, player_count, &projection);'
+ *       'camera_interest_entities(&interest, x, y, z, radius, entity_count);'
+ *   3. 'count = camera_interest_visible_entities(&interest, k, entities);  // Replicate these to player k'
+ *      'camera_interest_aabb(&interest, center, extents, cameras);      // Or: send this event to these players'
+ *
+ *  Pick cell_size close to the size of the larger entities, the far plane should span a few cells.
+ *  The far plane of the projection is the interest range. Use a smaller far plane than for rendering.
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+
+#ifndef CAMERA_INTEREST_HEADER_GUARD
+#define CAMERA_INTEREST_HEADER_GUARD
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Interest defines */
+
+// Number of uint32_t words of a camera bitset with _capacity cameras
+#define CAMERA_INTEREST_WORDS(_capacity)    (((_capacity) + 31) / 32)
+
+
+/* Interest structs */
+
+// Frustum of one camera slot as inserted into the index
+typedef struct camera_interest_view {
+    uint32_t generation;                // Camera generation the frustum was built from. 0 if the slot is not inserted.
+    float pose[9];                      // Camera eye, forward and up the frustum was built from
+    bool global;                        // Spans more cells than there are buckets, candidate of every query
+    int32_t cell_min[3];                // Cells overlapped by the bounds (inclusive)
+    int32_t cell_max[3];
+    float bounds_min[3];                // World space bounds of the frustum
+    float bounds_max[3];
+    CameraFrustum frustum;
+} CameraInterestView;
+
+typedef struct camera_interest {
+    uint32_t camera_capacity;
+    uint32_t camera_count;              // Cameras passed to the last camera_interest_update(..)
+    uint32_t words;                     // CAMERA_INTEREST_WORDS(camera_capacity)
+    uint32_t bucket_count;              // Power of two
+    float cell_size;
+    float inverse_cell_size;
+    CameraProjection projection;        // Projection the frustums were built with
+    CameraInterestView* views;          // [camera_capacity]
+    uint32_t* buckets;                  // [bucket_count * words] bit k is set if the bounds of camera k overlap a cell of the bucket
+    uint32_t* global;                   // [words] bit k is set if camera k is global
+
+    // Entities of the last camera_interest_entities(..) call
+    uint32_t entity_capacity;
+    uint32_t entity_count;
+    float entity_radius;                // Largest entity radius
+    float entity_min[3];                // Bounds of the entity centers
+    float entity_max[3];
+    const float* entity_x;              // The arrays passed to camera_interest_entities(..)
+    const float* entity_y;
+    const float* entity_z;
+    const float* entity_radii;          // NULL for points
+    uint32_t* entity_start;             // [bucket_count + 1] first entry of every bucket in entity_order
+    uint32_t* entity_order;             // [entity_capacity] entity indices sorted by bucket
+} CameraInterest;
+
+
+/* Function declarations */
+
+// Returns the number of bytes required for an index of _camera_capacity cameras and _entity_capacity entities
+//  _bucket_count is rounded up to a power of two (0 selects 1024).
+extern size_t camera_interest_memory_size(uint32_t _camera_capacity, uint32_t _entity_capacity, uint32_t _bucket_count);
+
+// Build an empty index in _memory
+//  More buckets mean less collisions, but more memory (_bucket_count * CAMERA_INTEREST_WORDS(_camera_capacity) words).
+// Note: _memory is expected to be aligned to CAMERA_POOL_ALIGNMENT and hold camera_interest_memory_size(..) bytes
+// Note: _cell_size is expected to be > 0
+extern CameraInterest camera_interest_init(void* _memory, uint32_t _camera_capacity, uint32_t _entity_capacity, uint32_t _bucket_count, float _cell_size);
+
+// Re-insert the cameras whose generation or pose (eye, forward, up) changed since the last call
+//  Camera k occupies slot k. Slots may be reassigned to other cameras (ex. by camera_pool_remove(..)) between calls.
+//  Slots of cameras with generation 0 (never updated) and slots >= _count are removed.
+//  A different _proj than before re-inserts all cameras. Returns the number of slots inserted or removed.
+// Note: the derived state of the cameras (forward, up, right, eye) is used, update them before
+// Note: positions are compared as they are. With CAMERA_MODE_FLOATING_ORIGIN all cameras are expected to share one origin.
+// Note: _count is expected to be <= camera_capacity
+extern uint32_t camera_interest_update(CameraInterest* _interest, const Camera* _cams, uint32_t _count, const CameraProjection* _proj);
+
+// Sort _count entities into the index, replacing the previous ones
+//  Entity i is a sphere at (_x[i], _y[i], _z[i]) with _radius[i]. Pass NULL as _radius for points.
+// Note: the arrays are referenced, not copied. They are expected to stay valid until the next call.
+// Note: _count is expected to be <= entity_capacity
+extern void camera_interest_entities(CameraInterest* _interest, const float* _x, const float* _y, const float* _z, const float* _radius, uint32_t _count);
+
+// Find the cameras that can see _point
+//  Bit (k % 32) of _out_cameras[k / 32] is set if camera k sees the point. Returns the number of cameras.
+// Note: _out_cameras is expected to hold CAMERA_INTEREST_WORDS(camera_capacity) words
+extern uint32_t camera_interest_point(const CameraInterest* _interest, CameraVec3 _point, uint32_t* _out_cameras);
+
+// Same as camera_interest_point(..) for the axis aligned bounding box at _center with half size _extents
+extern uint32_t camera_interest_aabb(const CameraInterest* _interest, CameraVec3 _center, CameraVec3 _extents, uint32_t* _out_cameras);
+
+// Find the entities camera _camera can see
+//  Writes their indices in no particular order to _out_entities and returns their number.
+// Note: _out_entities is expected to hold entity_count elements
+extern uint32_t camera_interest_visible_entities(const CameraInterest* _interest, uint32_t _camera, uint32_t* _out_entities);
+
+#endif // !CAMERA_INTEREST_HEADER_GUARD
+
+
+
+#ifdef CAMERA_INTEREST_IMPLEMENTATION
+
+#define CAMERA__INTEREST_DEFAULT_BUCKETS    1024
+
+// Cell coordinates are clamped to this range, so they stay representable
+#define CAMERA__INTEREST_MAX_CELL           1.0e9f
+
+/* Cells */
+
+static inline uint32_t camera__interest_buckets(uint32_t _bucket_count)
+{
+    uint32_t buckets = 1;
+    while (buckets < (_bucket_count != 0 ? _bucket_count : CAMERA__INTEREST_DEFAULT_BUCKETS))
+    {
+        buckets <<= 1;
+    }
+    return buckets;
+}
+
+static inline int32_t camera__interest_cell(const CameraInterest* _interest, float _value)
+{
+    const float cell = cm_min(cm_max(_value * _interest->inverse_cell_size, -CAMERA__INTEREST_MAX_CELL), CAMERA__INTEREST_MAX_CELL);
+    const int32_t truncated = (int32_t)cell;
+    return truncated - (cell < (float)truncated ? 1 : 0); // Floor
+}
+
+static inline uint32_t camera__interest_hash(const CameraInterest* _interest, int32_t _x, int32_t _y, int32_t _z)
+{
+    const uint32_t hash = ((uint32_t)_x * 73856093u) ^ ((uint32_t)_y * 19349663u) ^ ((uint32_t)_z * 83492791u);
+    return hash & (_interest->bucket_count - 1);
+}
+
+// Cells overlapped by the box [_min; _max], returns false if there are more than bucket_count
+static inline bool camera__interest_cells(const CameraInterest* _interest, const float* _min, const float* _max, int32_t* _out_min, int32_t* _out_max)
+{
+    uint64_t cells = 1;
+    bool fits = true;
+    for (int i = 0; i < 3; ++i)
+    {
+        _out_min[i] = camera__interest_cell(_interest, _min[i]);
+        _out_max[i] = camera__interest_cell(_interest, _max[i]);
+        cells *= (uint64_t)((int64_t)_out_max[i] - (int64_t)_out_min[i] + 1); // Note: < 2^32 * 2^31, does not overflow
+        fits = fits && cells <= _interest->bucket_count;
+        cells = fits ? cells : _interest->bucket_count;
+    }
+    return fits;
+}
+
+
+/* Frustum */
+
+static inline bool camera__interest_sphere(const CameraFrustum* _frustum, float _x, float _y, float _z, float _radius)
+{
+    for (int p = 0; p < CAMERA_FRUSTUM_PLANES; ++p)
+    {
+        const float* plane = _frustum->planes[p];
+        if (plane[0] * _x + plane[1] * _y + plane[2] * _z + plane[3] < -_radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline bool camera__interest_box(const CameraFrustum* _frustum, const float* _center, const float* _extents)
+{
+    for (int p = 0; p < CAMERA_FRUSTUM_PLANES; ++p)
+    {
+        const float* plane = _frustum->planes[p];
+        const float radius = _extents[0] * (plane[0] < 0.0f ? -plane[0] : plane[0])
+                           + _extents[1] * (plane[1] < 0.0f ? -plane[1] : plane[1])
+                           + _extents[2] * (plane[2] < 0.0f ? -plane[2] : plane[2]);
+        if (plane[0] * _center[0] + plane[1] * _center[1] + plane[2] * _center[2] + plane[3] < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline void camera__interest_plane(float* _plane, CameraVec3 _normal, float _scale, CameraVec3 _point)
+{
+    _plane[0] = _normal.x * _scale;
+    _plane[1] = _normal.y * _scale;
+    _plane[2] = _normal.z * _scale;
+    _plane[3] = -cm_dot(_normal, _point) * _scale;
+}
+
+// Build the frustum and its bounds from the derived state of a camera
+//  The planes are built from the basis directly, which is exact and independent of the depth range flags.
+static inline void camera__interest_frustum(const Camera* _cam, const CameraProjection* _proj, CameraInterestView* _view)
+{
+    const CameraVec3 eye = _cam->eye;
+    const CameraVec3 f = _cam->forward;
+    const CameraVec3 r = _cam->right;
+    const CameraVec3 u = _cam->up;
+    const bool perspective = (_proj->flags & CAMERA_PROJECTION_ORTHOGRAPHIC) == 0;
+    const bool infinite = perspective && (_proj->flags & CAMERA_PROJECTION_INFINITE_FAR) != 0;
+
+    CameraFrustum* frustum = &_view->frustum;
+    camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_NEAR], f, 1.0f, cm_add(eye, cm_scale(f, _proj->near_plane)));
+    if (infinite)
+    {
+        float* plane = frustum->planes[CAMERA_FRUSTUM_FAR];
+        plane[0] = 0.0f;
+        plane[1] = 0.0f;
+        plane[2] = 0.0f;
+        plane[3] = 1.0f;
+    }
+    else
+    {
+        camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_FAR], cm_negate(f), 1.0f, cm_add(eye, cm_scale(f, _proj->far_plane)));
+    }
+
+    // Half size of the view volume at distance 1 (perspective) or everywhere (orthographic)
+    float halfY;
+    if (perspective)
+    {
+        float s, c;
+        cm_sincos(0.5f * _proj->fov_y, &s, &c);
+        halfY = s / c;
+    }
+    else
+    {
+        halfY = 0.5f * _proj->height;
+    }
+    const float halfX = halfY * _proj->aspect;
+
+    if (perspective)
+    {
+        // dot(right + f * halfX, p - eye) >= 0 for points right of the left plane
+        const float scaleX = 1.0f / cm_sqrt(1.0f + halfX * halfX);
+        const float scaleY = 1.0f / cm_sqrt(1.0f + halfY * halfY);
+        camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_LEFT], cm_add(r, cm_scale(f, halfX)), scaleX, eye);
+        camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_RIGHT], cm_add(cm_negate(r), cm_scale(f, halfX)), scaleX, eye);
+        camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_BOTTOM], cm_add(u, cm_scale(f, halfY)), scaleY, eye);
+        camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_TOP], cm_add(cm_negate(u), cm_scale(f, halfY)), scaleY, eye);
+    }
+    else
+    {
+        camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_LEFT], r, 1.0f, cm_add(eye, cm_scale(r, -halfX)));
+        camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_RIGHT], cm_negate(r), 1.0f, cm_add(eye, cm_scale(r, halfX)));
+        camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_BOTTOM], u, 1.0f, cm_add(eye, cm_scale(u, -halfY)));
+        camera__interest_plane(frustum->planes[CAMERA_FRUSTUM_TOP], cm_negate(u), 1.0f, cm_add(eye, cm_scale(u, halfY)));
+    }
+
+    if (infinite)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            _view->bounds_min[i] = -CAMERA__INTEREST_MAX_CELL;
+            _view->bounds_max[i] = CAMERA__INTEREST_MAX_CELL;
+        }
+        return;
+    }
+
+    // Bounds of the 8 corners
+    for (int i = 0; i < 3; ++i)
+    {
+        _view->bounds_min[i] = CAMERA__INTEREST_MAX_CELL;
+        _view->bounds_max[i] = -CAMERA__INTEREST_MAX_CELL;
+    }
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        const float depth = (corner & 4) ? _proj->far_plane : _proj->near_plane;
+        const float x = ((corner & 1) ? halfX : -halfX) * (perspective ? depth : 1.0f);
+        const float y = ((corner & 2) ? halfY : -halfY) * (perspective ? depth : 1.0f);
+        const CameraVec3 point = cm_add(cm_add(eye, cm_scale(f, depth)), cm_add(cm_scale(r, x), cm_scale(u, y)));
+        const float coords[3] = { point.x, point.y, point.z };
+        for (int i = 0; i < 3; ++i)
+        {
+            _view->bounds_min[i] = cm_min(_view->bounds_min[i], coords[i]);
+            _view->bounds_max[i] = cm_max(_view->bounds_max[i], coords[i]);
+        }
+    }
+}
+
+
+/* Index */
+
+extern size_t camera_interest_memory_size(uint32_t _camera_capacity, uint32_t _entity_capacity, uint32_t _bucket_count)
+{
+    const size_t buckets = camera__interest_buckets(_bucket_count);
+    const size_t words = CAMERA_INTEREST_WORDS(_camera_capacity);
+    return _camera_capacity * sizeof(CameraInterestView)
+        + (buckets * words + words) * sizeof(uint32_t)
+        + (buckets + 1 + _entity_capacity) * sizeof(uint32_t);
+}
+
+extern CameraInterest camera_interest_init(void* _memory, uint32_t _camera_capacity, uint32_t _entity_capacity, uint32_t _bucket_count, float _cell_size)
+{
+    CameraInterest interest;
+    interest.camera_capacity = _camera_capacity;
+    interest.camera_count = 0;
+    interest.words = CAMERA_INTEREST_WORDS(_camera_capacity);
+    interest.bucket_count = camera__interest_buckets(_bucket_count);
+    interest.cell_size = _cell_size;
+    interest.inverse_cell_size = 1.0f / _cell_size;
+    interest.projection.flags = 0; // Matches no valid projection, the first update inserts all cameras
+    interest.projection.fov_y = 0.0f;
+    interest.projection.height = 0.0f;
+    interest.projection.aspect = 0.0f;
+    interest.projection.near_plane = 0.0f;
+    interest.projection.far_plane = 0.0f;
+
+    interest.views = (CameraInterestView*)_memory;
+    interest.buckets = (uint32_t*)(interest.views + _camera_capacity); // Note: Views keep the word arrays aligned
+    interest.global = interest.buckets + (size_t)interest.bucket_count * interest.words;
+    interest.entity_start = interest.global + interest.words;
+    interest.entity_order = interest.entity_start + interest.bucket_count + 1;
+
+    for (uint32_t k = 0; k < _camera_capacity; ++k)
+    {
+        interest.views[k].generation = 0;
+        interest.views[k].global = false;
+    }
+    for (size_t i = 0; i < (size_t)interest.bucket_count * interest.words + interest.words; ++i)
+    {
+        interest.buckets[i] = 0; // Includes global
+    }
+
+    interest.entity_capacity = _entity_capacity;
+    interest.entity_count = 0;
+    interest.entity_radius = 0.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        interest.entity_min[i] = 0.0f;
+        interest.entity_max[i] = 0.0f;
+    }
+    interest.entity_x = NULL;
+    interest.entity_y = NULL;
+    interest.entity_z = NULL;
+    interest.entity_radii = NULL;
+    for (uint32_t b = 0; b <= interest.bucket_count; ++b)
+    {
+        interest.entity_start[b] = 0;
+    }
+
+    return interest;
+}
+
+// Set (or clear) bit _camera in all buckets of the cells of its view
+static inline void camera__interest_mark(CameraInterest* _interest, uint32_t _camera, bool _set)
+{
+    const CameraInterestView* view = &_interest->views[_camera];
+    const uint32_t word = _camera / 32;
+    const uint32_t bit = UINT32_C(1) << (_camera % 32);
+
+    if (view->global)
+    {
+        _interest->global[word] = _set ? (_interest->global[word] | bit) : (_interest->global[word] & ~bit);
+        return;
+    }
+
+    for (int32_t z = view->cell_min[2]; z <= view->cell_max[2]; ++z)
+    {
+        for (int32_t y = view->cell_min[1]; y <= view->cell_max[1]; ++y)
+        {
+            for (int32_t x = view->cell_min[0]; x <= view->cell_max[0]; ++x)
+            {
+                uint32_t* bucket = &_interest->buckets[(size_t)camera__interest_hash(_interest, x, y, z) * _interest->words];
+                bucket[word] = _set ? (bucket[word] | bit) : (bucket[word] & ~bit);
+            }
+        }
+    }
+}
+
+static inline void camera__interest_pose(const Camera* _cam, float* _out_pose)
+{
+    const CameraVec3 vectors[3] = { _cam->eye, _cam->forward, _cam->up };
+    for (int i = 0; i < 3; ++i)
+    {
+        _out_pose[3 * i + 0] = vectors[i].x;
+        _out_pose[3 * i + 1] = vectors[i].y;
+        _out_pose[3 * i + 2] = vectors[i].z;
+    }
+}
+
+// Returns true if the view was built from the pose of _cam
+//  Generations are update counters, not identities: another camera moved into the slot may have the same one.
+static inline bool camera__interest_same_pose(const CameraInterestView* _view, const Camera* _cam)
+{
+    float pose[9];
+    camera__interest_pose(_cam, pose);
+    bool same = true;
+    for (int i = 0; i < 9; ++i)
+    {
+        same = same && pose[i] == _view->pose[i];
+    }
+    return same;
+}
+
+static inline bool camera__interest_same_projection(const CameraProjection* _a, const CameraProjection* _b)
+{
+    return _a->flags == _b->flags
+        && _a->fov_y == _b->fov_y
+        && _a->height == _b->height
+        && _a->aspect == _b->aspect
+        && _a->near_plane == _b->near_plane
+        && _a->far_plane == _b->far_plane;
+}
+
+extern uint32_t camera_interest_update(CameraInterest* _interest, const Camera* _cams, uint32_t _count, const CameraProjection* _proj)
+{
+    const bool reinsert = !camera__interest_same_projection(&_interest->projection, _proj);
+    _interest->projection = *_proj;
+
+    uint32_t changed = 0;
+    const uint32_t slots = _count > _interest->camera_count ? _count : _interest->camera_count;
+    for (uint32_t k = 0; k < slots; ++k)
+    {
+        CameraInterestView* view = &_interest->views[k];
+        const uint32_t generation = k < _count ? _cams[k].generation : 0;
+        if (generation == view->generation && (generation == 0 || (!reinsert && camera__interest_same_pose(view, &_cams[k]))))
+        {
+            continue; // Idle camera, or still not inserted
+        }
+
+        if (view->generation != 0)
+        {
+            camera__interest_mark(_interest, k, false);
+        }
+
+        view->generation = generation;
+        if (generation != 0)
+        {
+            camera__interest_pose(&_cams[k], view->pose);
+            camera__interest_frustum(&_cams[k], _proj, view);
+            view->global = !camera__interest_cells(_interest, view->bounds_min, view->bounds_max, view->cell_min, view->cell_max);
+            camera__interest_mark(_interest, k, true);
+        }
+        changed++;
+    }
+    _interest->camera_count = _count;
+
+    return changed;
+}
+
+extern void camera_interest_entities(CameraInterest* _interest, const float* _x, const float* _y, const float* _z, const float* _radius, uint32_t _count)
+{
+    _interest->entity_count = _count;
+    _interest->entity_x = _x;
+    _interest->entity_y = _y;
+    _interest->entity_z = _z;
+    _interest->entity_radii = _radius;
+
+    // Counting sort by bucket, entity_start[b + 1] holds the count of bucket b first
+    uint32_t* start = _interest->entity_start;
+    for (uint32_t b = 0; b <= _interest->bucket_count; ++b)
+    {
+        start[b] = 0;
+    }
+
+    float radius = 0.0f;
+    float min[3] = { CAMERA__INTEREST_MAX_CELL, CAMERA__INTEREST_MAX_CELL, CAMERA__INTEREST_MAX_CELL };
+    float max[3] = { -CAMERA__INTEREST_MAX_CELL, -CAMERA__INTEREST_MAX_CELL, -CAMERA__INTEREST_MAX_CELL };
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+        min[0] = cm_min(min[0], _x[i]);
+        min[1] = cm_min(min[1], _y[i]);
+        min[2] = cm_min(min[2], _z[i]);
+        max[0] = cm_max(max[0], _x[i]);
+        max[1] = cm_max(max[1], _y[i]);
+        max[2] = cm_max(max[2], _z[i]);
+
+        const uint32_t bucket = camera__interest_hash(_interest,
+            camera__interest_cell(_interest, _x[i]), camera__interest_cell(_interest, _y[i]), camera__interest_cell(_interest, _z[i]));
+        start[bucket + 1]++;
+        radius = _radius != NULL ? cm_max(radius, _radius[i]) : radius;
+    }
+    _interest->entity_radius = radius;
+    for (int i = 0; i < 3; ++i)
+    {
+        _interest->entity_min[i] = min[i];
+        _interest->entity_max[i] = max[i];
+    }
+
+    for (uint32_t b = 0; b < _interest->bucket_count; ++b)
+    {
+        start[b + 1] += start[b];
+    }
+
+    // Place the entities and shift every start to the following bucket, then shift back
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+        const uint32_t bucket = camera__interest_hash(_interest,
+            camera__interest_cell(_interest, _x[i]), camera__interest_cell(_interest, _y[i]), camera__interest_cell(_interest, _z[i]));
+        _interest->entity_order[start[bucket]++] = i;
+    }
+    for (uint32_t b = _interest->bucket_count; b > 0; --b)
+    {
+        start[b] = start[b - 1];
+    }
+    start[0] = 0;
+}
+
+
+/* Queries */
+
+// Test the candidate cameras (bitset) against the box and write the visible ones
+static inline uint32_t camera__interest_test(const CameraInterest* _interest, uint32_t* _candidates, const float* _center, const float* _extents)
+{
+    uint32_t count = 0;
+    for (uint32_t w = 0; w < _interest->words; ++w)
+    {
+        const uint32_t bits = _candidates[w];
+        uint32_t visible = 0;
+        for (uint32_t index = 0; index < 32 && (bits >> index) != 0; ++index)
+        {
+            const uint32_t bit = UINT32_C(1) << index;
+            if ((bits & bit) == 0)
+            {
+                continue;
+            }
+
+            const CameraInterestView* view = &_interest->views[w * 32 + index];
+            bool inside = true;
+            for (int i = 0; i < 3; ++i)
+            {
+                inside = inside && _center[i] + _extents[i] >= view->bounds_min[i] && _center[i] - _extents[i] <= view->bounds_max[i];
+            }
+            if (inside && camera__interest_box(&view->frustum, _center, _extents))
+            {
+                visible |= bit;
+                count++;
+            }
+        }
+        _candidates[w] = visible;
+    }
+    return count;
+}
+
+extern uint32_t camera_interest_point(const CameraInterest* _interest, CameraVec3 _point, uint32_t* _out_cameras)
+{
+    return camera_interest_aabb(_interest, _point, cm_init_vec3(0.0f, 0.0f, 0.0f), _out_cameras);
+}
+
+extern uint32_t camera_interest_aabb(const CameraInterest* _interest, CameraVec3 _center, CameraVec3 _extents, uint32_t* _out_cameras)
+{
+    const float center[3] = { _center.x, _center.y, _center.z };
+    const float extents[3] = { _extents.x, _extents.y, _extents.z };
+    const float min[3] = { center[0] - extents[0], center[1] - extents[1], center[2] - extents[2] };
+    const float max[3] = { center[0] + extents[0], center[1] + extents[1], center[2] + extents[2] };
+
+    for (uint32_t w = 0; w < _interest->words; ++w)
+    {
+        _out_cameras[w] = _interest->global[w];
+    }
+
+    int32_t cellMin[3], cellMax[3];
+    if (!camera__interest_cells(_interest, min, max, cellMin, cellMax))
+    {
+        // Every bucket is likely hit, test all inserted cameras
+        for (uint32_t k = 0; k < _interest->camera_count; ++k)
+        {
+            _out_cameras[k / 32] |= _interest->views[k].generation != 0 ? UINT32_C(1) << (k % 32) : 0;
+        }
+    }
+    else
+    {
+        for (int32_t z = cellMin[2]; z <= cellMax[2]; ++z)
+        {
+            for (int32_t y = cellMin[1]; y <= cellMax[1]; ++y)
+            {
+                for (int32_t x = cellMin[0]; x <= cellMax[0]; ++x)
+                {
+                    const uint32_t* bucket = &_interest->buckets[(size_t)camera__interest_hash(_interest, x, y, z) * _interest->words];
+                    for (uint32_t w = 0; w < _interest->words; ++w)
+                    {
+                        _out_cameras[w] |= bucket[w];
+                    }
+                }
+            }
+        }
+    }
+
+    return camera__interest_test(_interest, _out_cameras, center, extents);
+}
+
+static inline bool camera__interest_entity_visible(const CameraInterest* _interest, const CameraInterestView* _view, uint32_t _entity)
+{
+    const float radius = _interest->entity_radii != NULL ? _interest->entity_radii[_entity] : 0.0f;
+    return camera__interest_sphere(&_view->frustum, _interest->entity_x[_entity], _interest->entity_y[_entity], _interest->entity_z[_entity], radius);
+}
+
+extern uint32_t camera_interest_visible_entities(const CameraInterest* _interest, uint32_t _camera, uint32_t* _out_entities)
+{
+    const CameraInterestView* view = &_interest->views[_camera];
+    if (_camera >= _interest->camera_count || view->generation == 0)
+    {
+        return 0;
+    }
+
+    // Entity centers within the largest radius of the bounds
+    //  Clipped to the bounds of all centers, which skips the cells above and below a flat world.
+    const float radius = _interest->entity_radius;
+    float min[3], max[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        min[i] = cm_max(view->bounds_min[i] - radius, _interest->entity_min[i]);
+        max[i] = cm_min(view->bounds_max[i] + radius, _interest->entity_max[i]);
+        if (min[i] > max[i])
+        {
+            return 0;
+        }
+    }
+    int32_t cellMin[3], cellMax[3];
+
+    uint32_t count = 0;
+    if (!camera__interest_cells(_interest, min, max, cellMin, cellMax))
+    {
+        for (uint32_t i = 0; i < _interest->entity_count; ++i)
+        {
+            if (camera__interest_entity_visible(_interest, view, i))
+            {
+                _out_entities[count++] = i;
+            }
+        }
+        return count;
+    }
+
+    for (int32_t z = cellMin[2]; z <= cellMax[2]; ++z)
+    {
+        for (int32_t y = cellMin[1]; y <= cellMax[1]; ++y)
+        {
+            for (int32_t x = cellMin[0]; x <= cellMax[0]; ++x)
+            {
+                const uint32_t bucket = camera__interest_hash(_interest, x, y, z);
+                for (uint32_t e = _interest->entity_start[bucket]; e < _interest->entity_start[bucket + 1]; ++e)
+                {
+                    // Buckets are shared by many cells, only take the entities of this cell (each is visited once)
+                    const uint32_t i = _interest->entity_order[e];
+                    if (camera__interest_cell(_interest, _interest->entity_x[i]) == x
+                        && camera__interest_cell(_interest, _interest->entity_y[i]) == y
+                        && camera__interest_cell(_interest, _interest->entity_z[i]) == z
+                        && camera__interest_entity_visible(_interest, view, i))
+                    {
+                        _out_entities[count++] = i;
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
+#endif // CAMERA_INTEREST_IMPLEMENTATION
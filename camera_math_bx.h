@@ -66,6 +66,10 @@ static inline CameraVec3 cm_cross(CameraVec3 _a, CameraVec3 _b) {
     return bx::cross(_a, _b);
 }
 
+static inline float cm_dot(CameraVec3 _a, CameraVec3 _b) {
+    return bx::dot(_a, _b);
+}
+
 static inline float cm_min(float _a, float _b) {
     return bx::min(_a, _b);
 }
@@ -78,8 +82,21 @@ static inline float cm_sqrt(float _a) {
     return bx::sqrt(_a);
 }
 
-static inline CameraVec3 cm_toEuler(CameraQuat _a) {
-    return bx::toEuler(_a);
+static inline float cm_asin(float _a) {
+    return bx::asin(_a);
+}
+
+static inline float cm_atan2(float _y, float _x) {
+    return bx::atan2(_y, _x);
+}
+
+static inline float cm_exp(float _a) {
+    return bx::exp(_a);
+}
+
+static inline void cm_sincos(float _a, float* _sin, float* _cos) {
+    *_sin = bx::sin(_a);
+    *_cos = bx::cos(_a);
 }
 
 static inline CameraQuat cm_fromAxisAngle(CameraVec3 _a, float _b) {
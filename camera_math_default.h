@@ -68,6 +68,10 @@
 
 #include <math.h>
 
+#if defined(CAMERA_MATH_FAST)
+#include "camera_math_fast.h"
+#endif
+
 
 struct vec3 {
     float x, y, z;
@@ -152,6 +156,10 @@ static inline CameraVec3 cm_cross(CameraVec3 _a, CameraVec3 _b) {
     /// Adaption end
 }
 
+static inline float cm_dot(CameraVec3 _a, CameraVec3 _b) {
+    return _a.x * _b.x + _a.y * _b.y + _a.z * _b.z;
+}
+
 static inline float cm_min(float _a, float _b) {
     return (_a < _b) ? _a : _b;
 }
@@ -164,34 +172,46 @@ static inline float cm_sqrt(float _a) {
     return sqrtf(_a);
 }
 
-static inline CameraVec3 cm_toEuler(CameraQuat _a) {
-    /// Adapted from bx/include/bx/inline/math.inl#L927 function toEuler
-    const float xx = _a.x;
-    const float yy = _a.y;
-    const float zz = _a.z;
-    const float ww = _a.w;
-    const float xsq = xx * xx;
-    const float ysq = yy * yy;
-    const float zsq = zz * zz;
+static inline float cm_asin(float _a) {
+#if defined(CAMERA_MATH_FAST)
+    return cm_fast_asin(_a);
+#else
+    return asinf(_a);
+#endif
+}
 
-    return cm_init_vec3(
-        atan2f(2.0f * (xx * ww - yy * zz), 1.0f - 2.0f * (xsq + zsq)),
-        atan2f(2.0f * (yy * ww + xx * zz), 1.0f - 2.0f * (ysq + zsq)),
-        asinf(2.0f * (xx * yy + zz * ww))
-    );
-    /// Adaption end
+static inline float cm_atan2(float _y, float _x) {
+#if defined(CAMERA_MATH_FAST)
+    return cm_fast_atan2(_y, _x);
+#else
+    return atan2f(_y, _x);
+#endif
+}
+
+static inline float cm_exp(float _a) {
+    return expf(_a);
+}
+
+static inline void cm_sincos(float _a, float* _sin, float* _cos) {
+#if defined(CAMERA_MATH_FAST)
+    cm_fast_sincos(_a, _sin, _cos);
+#else
+    *_sin = sinf(_a);
+    *_cos = cosf(_a);
+#endif
 }
 
 static inline CameraQuat cm_fromAxisAngle(CameraVec3 _axis, float _angle) {
     /// Adapted from bx/include/bx/inline/math.inl#L996 function fromAxisAngle
     const float ha = _angle * 0.5f;
-    const float sa = sinf(ha);
+    float sa, ca;
+    cm_sincos(ha, &sa, &ca);
 
     return cm_init_quat(
         _axis.x * sa,
         _axis.y * sa,
         _axis.z * sa,
-        cosf(ha)
+        ca
     );
     /// Adaption end
 }
@@ -201,7 +221,11 @@ static inline CameraQuat cm_normalizeQuat(CameraQuat _a) {
     const float norm = _a.x * _a.x + _a.y * _a.y + _a.z * _a.z + _a.w * _a.w;
     if (0.0f < norm)
     {
+#if defined(CAMERA_MATH_FAST)
+        const float invNorm = cm_fast_rsqrt(norm);
+#else
         const float invNorm = powf(norm, -0.5f);
+#endif
 
         _a.x *= invNorm;
         _a.y *= invNorm;
@@ -216,7 +240,11 @@ static inline CameraQuat cm_normalizeQuat(CameraQuat _a) {
 
 static inline CameraVec3 cm_normalizeVec3(CameraVec3 _a) {
     /// Adapted from bx/include/bx/inline/math.inl#L663 function normalize
+#if defined(CAMERA_MATH_FAST)
+    const float invLen = cm_fast_rsqrt(_a.x * _a.x + _a.y * _a.y + _a.z * _a.z);
+#else
     const float invLen = 1.0f / sqrtf(_a.x * _a.x + _a.y * _a.y + _a.z * _a.z);
+#endif
     return cm_scale(_a, invLen);
     /// Adaption end
 }
@@ -0,0 +1,128 @@
+/*
+ * INFO:
+ * 
+ *  This file provides fast approximations of the transcendental functions used by the camera_math_*.h backends.
+ *  It is only included by a backend if CAMERA_MATH_FAST is defined before including camera.h.
+ * 
+ *  Per-frame camera rotations are small angles, for which libm accuracy is rarely needed.
+ *  The approximations trade a bounded error for branch-light polynomial code:
+ *   - cm_fast_sincos    max. abs. error 2e-7 for |_a| < 1e4 (minimax polynomials on [-pi/4; pi/4])
+ *   - cm_fast_atan2     max. abs. error 2e-6 rad (minimax polynomial on [0; 1])
+ *   - cm_fast_asin      max. abs. error 2e-6 rad (via cm_fast_atan2)
+ *   - cm_fast_rsqrt     max. rel. error 5e-7 (rsqrtss and one Newton-Raphson step with SSE,
+ *                        otherwise a bit estimate, one modified and one Newton-Raphson step)
+ * 
+ *  This keeps the precise manipulation guarantee: 'camera_rotate(&camera, {45 * DEG_TO_RAD, 0, 0});'
+ *   rotates by 45 degrees within 4e-7 radians (the half angle sine and cosine errors combined).
+ *  Angle clamping limits are met within the cm_fast_atan2 error.
+ * 
+ * 
+ * LICENSE:
+ * 
+ *  MIT License
+ * 
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef CAMERA_MATH_FAST_HEADER_GUARD
+#define CAMERA_MATH_FAST_HEADER_GUARD
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CM_FAST_SSE
+#endif
+
+static inline void cm_fast_sincos(float _a, float* _sin, float* _cos) {
+    // Reduce to r in [-pi/4; pi/4] with _a = r + quadrant * pi/2
+    //  pi/2 is split into three parts (Cody-Waite), so the reduction stays exact for large quadrants.
+    const float quadrantF = _a * 0.636619772f;
+    const int32_t quadrant = (int32_t)(quadrantF + (quadrantF < 0.0f ? -0.5f : 0.5f));
+    const float q = (float)quadrant;
+    const float r = ((_a - q * 1.5703125f) - q * 4.83751297e-4f) - q * 7.54978995e-8f;
+    const float r2 = r * r;
+
+    // Cephes sinf/cosf minimax polynomials
+    const float s = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+    const float c = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+    switch (quadrant & 3)
+    {
+    case 0:  *_sin = s;  *_cos = c;  break;
+    case 1:  *_sin = c;  *_cos = -s; break;
+    case 2:  *_sin = -s; *_cos = -c; break;
+    default: *_sin = -c; *_cos = s;  break;
+    }
+}
+
+static inline float cm_fast_atan2(float _y, float _x) {
+    const float pi = 3.14159265358979f;
+
+    const float ax = _x < 0.0f ? -_x : _x;
+    const float ay = _y < 0.0f ? -_y : _y;
+    const float maxXY = ax > ay ? ax : ay;
+    const float minXY = ax > ay ? ay : ax;
+
+    if (maxXY == 0.0f)
+    {
+        return 0.0f;
+    }
+
+    // atan(t) for t in [0; 1]
+    const float t = minXY / maxXY;
+    const float t2 = t * t;
+    float r = t * (0.99997726f + t2 * (-0.33262347f + t2 * (0.19354346f + t2 * (-0.11643287f + t2 * (0.05265332f + t2 * -0.01172120f)))));
+
+    // Expand to all octants
+    r = ay > ax ? 0.5f * pi - r : r;
+    r = _x < 0.0f ? pi - r : r;
+    return _y < 0.0f ? -r : r;
+}
+
+static inline float cm_fast_asin(float _a) {
+    return cm_fast_atan2(_a, sqrtf((1.0f - _a) * (1.0f + _a)));
+}
+
+// Two dependent refinement steps at most, a longer chain is no faster than 1.0f / sqrtf(_a)
+static inline float cm_fast_rsqrt(float _a) {
+#if defined(CM_FAST_SSE)
+    const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(_a))); // 12 bits
+    return y * (1.5f - 0.5f * _a * y * y);
+#else
+    uint32_t bits;
+    memcpy(&bits, &_a, sizeof(bits));
+    bits = UINT32_C(0x5f1ffff9) - (bits >> 1);
+
+    float y;
+    memcpy(&y, &bits, sizeof(y));
+
+    // Modified Newton-Raphson step of Moroz et al. (2018) tuned to the magic constant (6.5e-4),
+    //  then a Newton-Raphson step scaled to balance its error around 1
+    y = y * 0.703952253f * (2.38924456f - _a * y * y);
+    y = y * (1.50000048f - 0.500000179f * _a * y * y);
+    return y;
+#endif
+}
+
+#endif // !CAMERA_MATH_FAST_HEADER_GUARD
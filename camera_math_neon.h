@@ -0,0 +1,272 @@
+/*
+ * INFO:
+ * 
+ *  This file provides an interface to math functions for camera.h
+ *  This is a NEON implementation (ARMv7 and AArch64), relying only on arm_neon.h and math.h
+ * 
+ *  Vectors and quaternions are stored in one float32x4_t register each.
+ *  Quaternion products, rotations, normalization and the matrix conversion are vectorized.
+ *  Normalization uses rsqrt with two Newton-Raphson steps instead of a division and square root.
+ *  Trigonometric functions remain scalar.
+ * 
+ * 
+ * LICENSE:
+ * 
+ *  MIT License
+ * 
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <arm_neon.h>
+#include <math.h>
+
+#if defined(CAMERA_MATH_FAST)
+#include "camera_math_fast.h"
+#endif
+
+
+// Anonymous structs are an extension (though supported by all major compilers), mark them as one to build warning-free with -Wpedantic
+#if defined(__GNUC__)
+#define CM_NEON_ANONYMOUS __extension__
+#else
+#define CM_NEON_ANONYMOUS
+#endif
+
+struct vec3 {
+    union {
+        float32x4_t m;
+        CM_NEON_ANONYMOUS struct { float x, y, z, w; }; // Note: w is unused and kept at 0
+    };
+
+    vec3() = default;
+    vec3(float32x4_t _m) : m(_m) {}
+    vec3(float _x, float _y, float _z) : x(_x), y(_y), z(_z), w(0.0f) {}
+};
+typedef struct vec3 Vec3;
+#define CameraVec3 Vec3
+
+struct quat {
+    union {
+        float32x4_t m;
+        CM_NEON_ANONYMOUS struct { float x, y, z, w; };
+    };
+
+    quat() = default;
+    quat(float32x4_t _m) : m(_m) {}
+    quat(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+};
+typedef struct quat Quat;
+#define CameraQuat Quat
+
+
+static inline float32x4_t cm_neon_set(float _x, float _y, float _z, float _w) {
+    const float values[4] = { _x, _y, _z, _w };
+    return vld1q_f32(values);
+}
+
+// Lane permutations
+static inline float32x4_t cm_neon_wzyx(float32x4_t _a) {
+    return vrev64q_f32(vextq_f32(_a, _a, 2));
+}
+
+static inline float32x4_t cm_neon_zwxy(float32x4_t _a) {
+    return vextq_f32(_a, _a, 2);
+}
+
+static inline float32x4_t cm_neon_yxwz(float32x4_t _a) {
+    return vrev64q_f32(_a);
+}
+
+static inline float32x4_t cm_neon_yzxw(float32x4_t _a) {
+    // (y, z, x, w): rotate the xyz lanes, keep w
+    const float32x4_t yzwx = vextq_f32(_a, _a, 1);
+    return vsetq_lane_f32(vgetq_lane_f32(_a, 0), vsetq_lane_f32(vgetq_lane_f32(_a, 3), yzwx, 3), 2);
+}
+
+// Sum of all lanes
+static inline float cm_neon_sum(float32x4_t _a) {
+#if defined(__aarch64__)
+    return vaddvq_f32(_a);
+#else
+    const float32x2_t sum = vadd_f32(vget_low_f32(_a), vget_high_f32(_a));
+    return vget_lane_f32(vpadd_f32(sum, sum), 0);
+#endif
+}
+
+// 1 / sqrt(_a) with two Newton-Raphson steps
+//  The estimate is only accurate to ~8 bits, each step doubles the precision (~16, then ~23 bits).
+static inline float32x4_t cm_neon_rsqrt(float32x4_t _a) {
+    float32x4_t y = vrsqrteq_f32(_a);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(_a, y), y));
+    return vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(_a, y), y));
+}
+
+// Cross product of the x, y and z lanes
+static inline float32x4_t cm_neon_cross(float32x4_t _a, float32x4_t _b) {
+    const float32x4_t c = vsubq_f32(vmulq_f32(_a, cm_neon_yzxw(_b)), vmulq_f32(cm_neon_yzxw(_a), _b));
+    return cm_neon_yzxw(c);
+}
+
+
+static inline CameraVec3 cm_init_vec3(float _x, float _y, float _z) {
+    return CameraVec3(_x, _y, _z);
+}
+
+static inline CameraQuat cm_init_quat(float _x, float _y, float _z, float _w) {
+    return CameraQuat(_x, _y, _z, _w);
+}
+
+static inline CameraQuat cm_invert(CameraQuat _a) {
+    return vmulq_f32(_a.m, cm_neon_set(-1.0f, -1.0f, -1.0f, 1.0f));
+}
+
+static inline CameraQuat cm_mulQuat(CameraQuat _a, CameraQuat _b) {
+    // Hamilton product, grouped by the components of _a:
+    //  aw * ( bx,  by,  bz,  bw)
+    //  ax * ( bw, -bz,  by, -bx)
+    //  ay * ( bz,  bw, -bx, -by)
+    //  az * (-by,  bx,  bw, -bz)
+    const float32x4_t a = _a.m;
+    const float32x4_t b = _b.m;
+
+    float32x4_t result = vmulq_n_f32(b, vgetq_lane_f32(a, 3));
+    result = vmlaq_n_f32(result, vmulq_f32(cm_neon_wzyx(b), cm_neon_set(1.0f, -1.0f, 1.0f, -1.0f)), vgetq_lane_f32(a, 0));
+    result = vmlaq_n_f32(result, vmulq_f32(cm_neon_zwxy(b), cm_neon_set(1.0f, 1.0f, -1.0f, -1.0f)), vgetq_lane_f32(a, 1));
+    result = vmlaq_n_f32(result, vmulq_f32(cm_neon_yxwz(b), cm_neon_set(-1.0f, 1.0f, 1.0f, -1.0f)), vgetq_lane_f32(a, 2));
+    return result;
+}
+
+static inline CameraVec3 cm_mul(CameraVec3 _v, CameraQuat _q) {
+    // Same as invert(_q) * _v * _q, expanded into two cross products
+    //  with u = -_q.xyz: t = 2 * cross(u, v), result = v + w * t + cross(u, t)
+    const float32x4_t u = vnegq_f32(_q.m);
+    const float32x4_t t = vmulq_n_f32(cm_neon_cross(u, _v.m), 2.0f);
+    const float32x4_t result = vaddq_f32(vmlaq_n_f32(_v.m, t, vgetq_lane_f32(_q.m, 3)), cm_neon_cross(u, t));
+    return vsetq_lane_f32(0.0f, result, 3);
+}
+
+static inline CameraVec3 cm_add(CameraVec3 _a, CameraVec3 _b) {
+    return vaddq_f32(_a.m, _b.m);
+}
+
+static inline CameraVec3 cm_scale(CameraVec3 _a, float _b) {
+    return vmulq_n_f32(_a.m, _b);
+}
+
+static inline CameraVec3 cm_cross(CameraVec3 _a, CameraVec3 _b) {
+    return cm_neon_cross(_a.m, _b.m);
+}
+
+static inline float cm_dot(CameraVec3 _a, CameraVec3 _b) {
+    return cm_neon_sum(vsetq_lane_f32(0.0f, vmulq_f32(_a.m, _b.m), 3));
+}
+
+static inline float cm_min(float _a, float _b) {
+    return (_a < _b) ? _a : _b;
+}
+
+static inline float cm_max(float _a, float _b) {
+    return (_a > _b) ? _a : _b;
+}
+
+static inline float cm_sqrt(float _a) {
+    return sqrtf(_a);
+}
+
+static inline float cm_asin(float _a) {
+#if defined(CAMERA_MATH_FAST)
+    return cm_fast_asin(_a);
+#else
+    return asinf(_a);
+#endif
+}
+
+static inline float cm_atan2(float _y, float _x) {
+#if defined(CAMERA_MATH_FAST)
+    return cm_fast_atan2(_y, _x);
+#else
+    return atan2f(_y, _x);
+#endif
+}
+
+static inline float cm_exp(float _a) {
+    return expf(_a);
+}
+
+static inline void cm_sincos(float _a, float* _sin, float* _cos) {
+#if defined(CAMERA_MATH_FAST)
+    cm_fast_sincos(_a, _sin, _cos);
+#else
+    *_sin = sinf(_a);
+    *_cos = cosf(_a);
+#endif
+}
+
+static inline CameraQuat cm_fromAxisAngle(CameraVec3 _axis, float _angle) {
+    float sa, ca;
+    cm_sincos(_angle * 0.5f, &sa, &ca);
+    return vsetq_lane_f32(ca, vmulq_n_f32(_axis.m, sa), 3);
+}
+
+static inline CameraQuat cm_normalizeQuat(CameraQuat _a) {
+    const float norm = cm_neon_sum(vmulq_f32(_a.m, _a.m));
+    if (0.0f < norm)
+    {
+        return vmulq_f32(_a.m, cm_neon_rsqrt(vdupq_n_f32(norm)));
+    }
+
+    return cm_init_quat(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+static inline CameraVec3 cm_normalizeVec3(CameraVec3 _a) {
+    const float lengthSq = cm_dot(_a, _a);
+    return vmulq_f32(_a.m, cm_neon_rsqrt(vdupq_n_f32(lengthSq)));
+}
+
+static inline CameraVec3 cm_negate(CameraVec3 _a) {
+    return vnegq_f32(_a.m);
+}
+
+static inline void cm_matrixFromQuat(float* _result, CameraQuat _rotation) {
+    const float32x4_t q = _rotation.m;
+    const float32x4_t q2 = vaddq_f32(q, q);
+
+    // (x2x, y2y, z2z, -), (x2y, x2z, y2z, -) and (x2w, y2w, z2w, -)
+    const float32x4_t d = vmulq_f32(q, q2);
+    const float32x4_t c = vmulq_f32(cm_neon_set(_rotation.x, _rotation.x, _rotation.y, 0.0f), cm_neon_set(vgetq_lane_f32(q2, 1), vgetq_lane_f32(q2, 2), vgetq_lane_f32(q2, 2), 0.0f));
+    const float32x4_t w = vmulq_n_f32(q2, _rotation.w);
+
+    // Off diagonal, in the order (m1, m2, m6) and (m4, m8, m9):
+    //  m1 = x2y - z2w   m2 = x2z + y2w   m6 = y2z - x2w
+    //  m4 = x2y + z2w   m8 = x2z - y2w   m9 = y2z + x2w
+    const float32x4_t wzyx = vmulq_f32(cm_neon_wzyx(vextq_f32(w, w, 3)), cm_neon_set(-1.0f, 1.0f, -1.0f, 0.0f)); // (-z2w, y2w, -x2w, 0)
+    const float32x4_t upper = vaddq_f32(c, wzyx);
+    const float32x4_t lower = vsubq_f32(c, wzyx);
+
+    const float d0 = 1.0f - (vgetq_lane_f32(d, 1) + vgetq_lane_f32(d, 2));
+    const float d1 = 1.0f - (vgetq_lane_f32(d, 0) + vgetq_lane_f32(d, 2));
+    const float d2 = 1.0f - (vgetq_lane_f32(d, 0) + vgetq_lane_f32(d, 1));
+
+    vst1q_f32(_result + 0, cm_neon_set(d0, vgetq_lane_f32(upper, 0), vgetq_lane_f32(upper, 1), 0.0f));
+    vst1q_f32(_result + 4, cm_neon_set(vgetq_lane_f32(lower, 0), d1, vgetq_lane_f32(upper, 2), 0.0f));
+    vst1q_f32(_result + 8, cm_neon_set(vgetq_lane_f32(lower, 1), vgetq_lane_f32(lower, 2), d2, 0.0f));
+    vst1q_f32(_result + 12, cm_neon_set(0.0f, 0.0f, 0.0f, 1.0f));
+}
@@ -0,0 +1,274 @@
+/*
+ * INFO:
+ * 
+ *  This file provides an interface to math functions for camera.h
+ *  This is a SSE2 implementation, relying only on emmintrin.h and math.h
+ * 
+ *  Vectors and quaternions are stored in one __m128 register each.
+ *  Quaternion products, rotations, normalization and the matrix conversion are vectorized.
+ *  Normalization uses rsqrt with one Newton-Raphson step instead of a division and square root.
+ *  Trigonometric functions remain scalar.
+ * 
+ * 
+ * LICENSE:
+ * 
+ *  MIT License
+ * 
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <emmintrin.h>
+#include <math.h>
+
+#if defined(CAMERA_MATH_FAST)
+#include "camera_math_fast.h"
+#endif
+
+
+// Anonymous structs are an extension (though supported by all major compilers), mark them as one to build warning-free with -Wpedantic
+#if defined(__GNUC__)
+#define CM_SSE_ANONYMOUS __extension__
+#else
+#define CM_SSE_ANONYMOUS
+#endif
+
+struct vec3 {
+    union {
+        __m128 m;
+        CM_SSE_ANONYMOUS struct { float x, y, z, w; }; // Note: w is unused and kept at 0
+    };
+
+    vec3() = default;
+    vec3(__m128 _m) : m(_m) {}
+    vec3(float _x, float _y, float _z) : m(_mm_setr_ps(_x, _y, _z, 0.0f)) {}
+};
+typedef struct vec3 Vec3;
+#define CameraVec3 Vec3
+
+struct quat {
+    union {
+        __m128 m;
+        CM_SSE_ANONYMOUS struct { float x, y, z, w; };
+    };
+
+    quat() = default;
+    quat(__m128 _m) : m(_m) {}
+    quat(float _x, float _y, float _z, float _w) : m(_mm_setr_ps(_x, _y, _z, _w)) {}
+};
+typedef struct quat Quat;
+#define CameraQuat Quat
+
+
+// Shuffle lanes of _a, lane indices are given in memory order
+#define CM_SSE_SHUFFLE(_a, _x, _y, _z, _w) _mm_shuffle_ps((_a), (_a), _MM_SHUFFLE((_w), (_z), (_y), (_x)))
+
+// Flip the sign of the lanes set to -0.0f
+static inline __m128 cm_sse_flip(__m128 _a, float _x, float _y, float _z, float _w) {
+    return _mm_xor_ps(_a, _mm_setr_ps(_x, _y, _z, _w));
+}
+
+// Sum of the x, y and z lanes, broadcast to all lanes
+static inline __m128 cm_sse_dot3(__m128 _a, __m128 _b) {
+    const __m128 mul = _mm_mul_ps(_a, _b);
+    const __m128 xy = _mm_add_ps(CM_SSE_SHUFFLE(mul, 0, 0, 0, 0), CM_SSE_SHUFFLE(mul, 1, 1, 1, 1));
+    return _mm_add_ps(xy, CM_SSE_SHUFFLE(mul, 2, 2, 2, 2));
+}
+
+// Sum of all lanes, broadcast to all lanes
+static inline __m128 cm_sse_dot4(__m128 _a, __m128 _b) {
+    const __m128 mul = _mm_mul_ps(_a, _b);
+    const __m128 sum = _mm_add_ps(mul, CM_SSE_SHUFFLE(mul, 1, 0, 3, 2));
+    return _mm_add_ps(sum, CM_SSE_SHUFFLE(sum, 2, 3, 0, 1));
+}
+
+// 1 / sqrt(_a) with one Newton-Raphson step (~22 bits of precision)
+static inline __m128 cm_sse_rsqrt(__m128 _a) {
+    const __m128 y = _mm_rsqrt_ps(_a);
+    const __m128 yy = _mm_mul_ps(y, y);
+    const __m128 half = _mm_mul_ps(_a, _mm_set1_ps(0.5f));
+    return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half, yy)));
+}
+
+// Cross product of the x, y and z lanes
+static inline __m128 cm_sse_cross(__m128 _a, __m128 _b) {
+    const __m128 a_yzx = CM_SSE_SHUFFLE(_a, 1, 2, 0, 3);
+    const __m128 b_yzx = CM_SSE_SHUFFLE(_b, 1, 2, 0, 3);
+    const __m128 c = _mm_sub_ps(_mm_mul_ps(_a, b_yzx), _mm_mul_ps(a_yzx, _b));
+    return CM_SSE_SHUFFLE(c, 1, 2, 0, 3);
+}
+
+
+static inline CameraVec3 cm_init_vec3(float _x, float _y, float _z) {
+    return CameraVec3(_x, _y, _z);
+}
+
+static inline CameraQuat cm_init_quat(float _x, float _y, float _z, float _w) {
+    return CameraQuat(_x, _y, _z, _w);
+}
+
+static inline CameraQuat cm_invert(CameraQuat _a) {
+    return cm_sse_flip(_a.m, -0.0f, -0.0f, -0.0f, 0.0f);
+}
+
+static inline CameraQuat cm_mulQuat(CameraQuat _a, CameraQuat _b) {
+    // Hamilton product, grouped by the components of _a:
+    //  aw * ( bx,  by,  bz,  bw)
+    //  ax * ( bw, -bz,  by, -bx)
+    //  ay * ( bz,  bw, -bx, -by)
+    //  az * (-by,  bx,  bw, -bz)
+    const __m128 a = _a.m;
+    const __m128 b = _b.m;
+
+    const __m128 rw = _mm_mul_ps(CM_SSE_SHUFFLE(a, 3, 3, 3, 3), b);
+    const __m128 rx = _mm_mul_ps(CM_SSE_SHUFFLE(a, 0, 0, 0, 0), cm_sse_flip(CM_SSE_SHUFFLE(b, 3, 2, 1, 0), 0.0f, -0.0f, 0.0f, -0.0f));
+    const __m128 ry = _mm_mul_ps(CM_SSE_SHUFFLE(a, 1, 1, 1, 1), cm_sse_flip(CM_SSE_SHUFFLE(b, 2, 3, 0, 1), 0.0f, 0.0f, -0.0f, -0.0f));
+    const __m128 rz = _mm_mul_ps(CM_SSE_SHUFFLE(a, 2, 2, 2, 2), cm_sse_flip(CM_SSE_SHUFFLE(b, 1, 0, 3, 2), -0.0f, 0.0f, 0.0f, -0.0f));
+
+    return _mm_add_ps(_mm_add_ps(rw, rx), _mm_add_ps(ry, rz));
+}
+
+static inline CameraVec3 cm_mul(CameraVec3 _v, CameraQuat _q) {
+    // Same as invert(_q) * _v * _q, expanded into two cross products
+    //  with u = -_q.xyz: t = 2 * cross(u, v), result = v + w * t + cross(u, t)
+    const __m128 u = cm_sse_flip(_q.m, -0.0f, -0.0f, -0.0f, -0.0f);
+    const __m128 t = _mm_add_ps(cm_sse_cross(u, _v.m), cm_sse_cross(u, _v.m));
+    const __m128 wt = _mm_mul_ps(CM_SSE_SHUFFLE(_q.m, 3, 3, 3, 3), t);
+    const __m128 result = _mm_add_ps(_mm_add_ps(_v.m, wt), cm_sse_cross(u, t));
+    return _mm_and_ps(result, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+}
+
+static inline CameraVec3 cm_add(CameraVec3 _a, CameraVec3 _b) {
+    return _mm_add_ps(_a.m, _b.m);
+}
+
+static inline CameraVec3 cm_scale(CameraVec3 _a, float _b) {
+    return _mm_mul_ps(_a.m, _mm_set1_ps(_b));
+}
+
+static inline CameraVec3 cm_cross(CameraVec3 _a, CameraVec3 _b) {
+    return cm_sse_cross(_a.m, _b.m);
+}
+
+static inline float cm_dot(CameraVec3 _a, CameraVec3 _b) {
+    return _mm_cvtss_f32(cm_sse_dot3(_a.m, _b.m));
+}
+
+static inline float cm_min(float _a, float _b) {
+    return _mm_cvtss_f32(_mm_min_ss(_mm_set_ss(_a), _mm_set_ss(_b)));
+}
+
+static inline float cm_max(float _a, float _b) {
+    return _mm_cvtss_f32(_mm_max_ss(_mm_set_ss(_a), _mm_set_ss(_b)));
+}
+
+static inline float cm_sqrt(float _a) {
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(_a)));
+}
+
+static inline float cm_asin(float _a) {
+#if defined(CAMERA_MATH_FAST)
+    return cm_fast_asin(_a);
+#else
+    return asinf(_a);
+#endif
+}
+
+static inline float cm_atan2(float _y, float _x) {
+#if defined(CAMERA_MATH_FAST)
+    return cm_fast_atan2(_y, _x);
+#else
+    return atan2f(_y, _x);
+#endif
+}
+
+static inline float cm_exp(float _a) {
+    return expf(_a);
+}
+
+static inline void cm_sincos(float _a, float* _sin, float* _cos) {
+#if defined(CAMERA_MATH_FAST)
+    cm_fast_sincos(_a, _sin, _cos);
+#else
+    *_sin = sinf(_a);
+    *_cos = cosf(_a);
+#endif
+}
+
+static inline CameraQuat cm_fromAxisAngle(CameraVec3 _axis, float _angle) {
+    float sa, ca;
+    cm_sincos(_angle * 0.5f, &sa, &ca);
+    const __m128 xyz = _mm_mul_ps(_axis.m, _mm_set1_ps(sa));
+    return _mm_add_ps(_mm_and_ps(xyz, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0))), _mm_setr_ps(0.0f, 0.0f, 0.0f, ca));
+}
+
+static inline CameraQuat cm_normalizeQuat(CameraQuat _a) {
+    const __m128 norm = cm_sse_dot4(_a.m, _a.m);
+    if (0.0f < _mm_cvtss_f32(norm))
+    {
+        return _mm_mul_ps(_a.m, cm_sse_rsqrt(norm));
+    }
+
+    return cm_init_quat(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+static inline CameraVec3 cm_normalizeVec3(CameraVec3 _a) {
+    return _mm_mul_ps(_a.m, cm_sse_rsqrt(cm_sse_dot3(_a.m, _a.m)));
+}
+
+static inline CameraVec3 cm_negate(CameraVec3 _a) {
+    return _mm_sub_ps(_mm_setzero_ps(), _a.m);
+}
+
+static inline void cm_matrixFromQuat(float* _result, CameraQuat _rotation) {
+    const __m128 q = _rotation.m;
+    const __m128 q2 = _mm_add_ps(q, q);
+
+    // (x2x, y2y, z2z, -), (x2y, x2z, y2z, -) and (x2w, y2w, z2w, -)
+    const __m128 d = _mm_mul_ps(q, q2);
+    const __m128 c = _mm_mul_ps(CM_SSE_SHUFFLE(q, 0, 0, 1, 3), CM_SSE_SHUFFLE(q2, 1, 2, 2, 3));
+    const __m128 w = _mm_mul_ps(q2, CM_SSE_SHUFFLE(q, 3, 3, 3, 3));
+
+    // Diagonal: 1 - (y2y + z2z), 1 - (x2x + z2z), 1 - (x2x + y2y)
+    const __m128 diagonal = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_add_ps(CM_SSE_SHUFFLE(d, 1, 0, 0, 3), CM_SSE_SHUFFLE(d, 2, 2, 1, 3)));
+
+    // Off diagonal, in the order (m1, m2, m6) and (m4, m8, m9):
+    //  m1 = x2y - z2w   m2 = x2z + y2w   m6 = y2z - x2w
+    //  m4 = x2y + z2w   m8 = x2z - y2w   m9 = y2z + x2w
+    const __m128 wzyx = cm_sse_flip(CM_SSE_SHUFFLE(w, 2, 1, 0, 3), -0.0f, 0.0f, -0.0f, 0.0f);
+    const __m128 upper = _mm_add_ps(c, wzyx);
+    const __m128 lower = _mm_sub_ps(c, wzyx);
+
+    const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+    // Rows: (d0, u0, u1, 0), (l0, d1, u2, 0), (l1, l2, d2, 0)
+    const __m128 du = _mm_shuffle_ps(diagonal, upper, _MM_SHUFFLE(1, 0, 1, 0));     // (d0, d1, u0, u1)
+    const __m128 row0 = _mm_and_ps(CM_SSE_SHUFFLE(du, 0, 2, 3, 3), mask);
+    const __m128 ld = _mm_shuffle_ps(lower, diagonal, _MM_SHUFFLE(2, 1, 1, 0));      // (l0, l1, d1, d2)
+    const __m128 row1 = _mm_and_ps(_mm_shuffle_ps(ld, upper, _MM_SHUFFLE(3, 2, 2, 0)), mask);
+    const __m128 row2 = _mm_and_ps(_mm_shuffle_ps(lower, diagonal, _MM_SHUFFLE(3, 2, 2, 1)), mask);
+    const __m128 row3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+    // Note: Unaligned stores, so any float[16] can be passed. They are as fast as aligned stores on aligned memory.
+    _mm_storeu_ps(_result + 0, row0);
+    _mm_storeu_ps(_result + 4, row1);
+    _mm_storeu_ps(_result + 8, row2);
+    _mm_storeu_ps(_result + 12, row3);
+}
@@ -0,0 +1,433 @@
+/*
+ * INFO:
+ *
+ *  This file provides cinematic camera paths through keyframes of target_position, target_distance and orientation.
+ *
+ *  Everything expensive is done once when building the path:
+ *   - target_position and target_distance follow a Catmull-Rom spline, stored as per segment polynomials
+ *   - orientation follows a squad interpolation, the intermediate control quaternions are precomputed
+ *   - an arc-length table maps distance along the path to a segment and its local parameter,
+ *     so the camera moves at constant speed regardless of the keyframe spacing
+ *     (the length covers target_position, target_distance and orientation at one unit per radian,
+ *      so keys that only turn or zoom the camera are travelled through as well)
+ *
+ *  Sampling is done through a CameraPathCursor. It remembers its position in the arc-length table,
+ *   so advancing it monotonically (ex. once per frame) costs amortized O(1) instead of a binary search.
+ *  camera_path_sample_batch(..) evaluates many cameras (each with its own cursor) on the same path.
+ *
+ *
+ * USAGE:
+ *
+ *  Include 'camera.h' first. ONE (and only ONE) source file must hold the implementation
+ *   by using '#define CAMERA_PATH_IMPLEMENTATION' before including 'camera_path.h'.
+ *
+ *  The path does not allocate. Query camera_path_memory_size(..) and pass aligned memory to camera_path_init(..).
+ *
+ *  Example:
+ *   1. 'CameraPath path = camera_path_init(memory, keys, key_count, 16);'
+ *   2. 'CameraPathCursor cursor = camera_path_cursor();'
+ *   3. Every frame: 'travelled += speed * dt;'
+ *                   'CameraPathSample sample = camera_path_sample(&path, &cursor, travelled);'
+ *                   'camera_path_apply(&sample, &camera);'
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+
+#ifndef CAMERA_PATH_HEADER_GUARD
+#define CAMERA_PATH_HEADER_GUARD
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Path structs */
+
+// A point the path passes through
+// Note: orientation is expected to be normalized
+typedef struct camera_path_key {
+    CameraVec3 target_position;
+    float target_distance;
+    CameraQuat orientation;
+} CameraPathKey;
+
+// Precomputed interpolation between two keys
+typedef struct camera_path_segment {
+    // Spline polynomials: value(t) = ((c3 * t + c2) * t + c1) * t + c0 with t in [0; 1]
+    CameraVec3 position[4];
+    float distance[4];
+
+    // Squad control quaternions: squad(q0, q1, s0, s1, t)
+    CameraQuat q0;
+    CameraQuat q1;
+    CameraQuat s0;
+    CameraQuat s1;
+} CameraPathSegment;
+
+typedef struct camera_path {
+    uint32_t segment_count;
+    uint32_t samples_per_segment;       // Arc-length table entries per segment
+    float length;                       // Total arc length (see camera_path_init(..))
+    CameraPathSegment* segments;        // [segment_count]
+    float* arc_lengths;                 // [segment_count * samples_per_segment + 1] arc length at every table entry
+} CameraPath;
+
+// Sampling position in a path
+typedef struct camera_path_cursor {
+    uint32_t entry;                     // Arc-length table entry at or before the last sampled distance
+} CameraPathCursor;
+
+// Interpolated state at some distance along a path
+typedef struct camera_path_sample {
+    CameraVec3 target_position;
+    float target_distance;
+    CameraQuat orientation;
+} CameraPathSample;
+
+
+/* Function declarations */
+
+// Returns the number of bytes required for a path through _key_count keys
+extern size_t camera_path_memory_size(uint32_t _key_count, uint32_t _samples_per_segment);
+
+// Build a path through _keys in _memory
+//  _samples_per_segment sets the arc-length table resolution (0 selects 16). More samples give a more even speed.
+//  A path through a single key stays at that key.
+//  The arc length combines the movement of target_position and target_distance with the rotation (one unit per radian),
+//   so segments that only rotate or zoom the camera take up distance along the path as well.
+// Note: _memory is expected to be aligned to CAMERA_POOL_ALIGNMENT and hold camera_path_memory_size(..) bytes
+// Note: _key_count is expected to be at least 1
+extern CameraPath camera_path_init(void* _memory, const CameraPathKey* _keys, uint32_t _key_count, uint32_t _samples_per_segment);
+
+// Returns a cursor at the start of a path
+extern CameraPathCursor camera_path_cursor();
+
+// Returns the state at _distance along the path and moves the cursor there
+//  _distance is clamped to [0; path.length]. Moving the cursor by small steps in either direction is amortized O(1).
+extern CameraPathSample camera_path_sample(const CameraPath* _path, CameraPathCursor* _cursor, float _distance);
+
+// Same as camera_path_sample(..) for _count cameras on the same path, each with its own cursor
+// Note: _cursors, _distances and _out are expected to hold _count elements
+extern void camera_path_sample_batch(const CameraPath* _path, CameraPathCursor* _cursors, const float* _distances, uint32_t _count, CameraPathSample* _out);
+
+// Overwrite target_position, target_distance and orientation of _cam with the sample
+//  The changes are applied by the next camera_view_matrix(..) as with any direct manipulation.
+extern void camera_path_apply(const CameraPathSample* _sample, Camera* _cam);
+
+#endif // !CAMERA_PATH_HEADER_GUARD
+
+
+
+#ifdef CAMERA_PATH_IMPLEMENTATION
+
+#define CAMERA__PATH_DEFAULT_SAMPLES        16
+
+/* Quaternion helpers */
+
+// Note: Squad is defined on the Hamilton product, which is spelled out here
+//  so the path does not depend on the multiplication order of the camera_math.h backend.
+
+static inline CameraQuat camera__path_mul(CameraQuat _a, CameraQuat _b)
+{
+    return cm_init_quat(
+        _a.w * _b.x + _a.x * _b.w + _a.y * _b.z - _a.z * _b.y,
+        _a.w * _b.y - _a.x * _b.z + _a.y * _b.w + _a.z * _b.x,
+        _a.w * _b.z + _a.x * _b.y - _a.y * _b.x + _a.z * _b.w,
+        _a.w * _b.w - _a.x * _b.x - _a.y * _b.y - _a.z * _b.z
+    );
+}
+
+static inline CameraQuat camera__path_conjugate(CameraQuat _q)
+{
+    return cm_init_quat(-_q.x, -_q.y, -_q.z, _q.w);
+}
+
+static inline float camera__path_dot(CameraQuat _a, CameraQuat _b)
+{
+    return _a.x * _b.x + _a.y * _b.y + _a.z * _b.z + _a.w * _b.w;
+}
+
+// Logarithm of a unit quaternion, returned as the vector part of a pure quaternion (w = 0)
+static inline CameraQuat camera__path_log(CameraQuat _q)
+{
+    const float length = cm_sqrt(_q.x * _q.x + _q.y * _q.y + _q.z * _q.z);
+    const float angle = cm_atan2(length, _q.w);
+    const float scale = length > 1e-7f ? angle / length : 1.0f; // lim angle / length = 1
+    return cm_init_quat(_q.x * scale, _q.y * scale, _q.z * scale, 0.0f);
+}
+
+// Exponential of a pure quaternion
+static inline CameraQuat camera__path_exp(CameraQuat _q)
+{
+    const float angle = cm_sqrt(_q.x * _q.x + _q.y * _q.y + _q.z * _q.z);
+    float s, c;
+    cm_sincos(angle, &s, &c);
+    const float scale = angle > 1e-7f ? s / angle : 1.0f; // lim sin(angle) / angle = 1
+    return cm_init_quat(_q.x * scale, _q.y * scale, _q.z * scale, c);
+}
+
+// Angle between two unit quaternions along the shorter arc
+//  From the chord |b - a| = 2 sin(angle / 4), which stays accurate for small angles unlike acos(dot)
+static inline float camera__path_angle(CameraQuat _a, CameraQuat _b)
+{
+    const float sign = camera__path_dot(_a, _b) < 0.0f ? -1.0f : 1.0f;
+    const float x = sign * _b.x - _a.x;
+    const float y = sign * _b.y - _a.y;
+    const float z = sign * _b.z - _a.z;
+    const float w = sign * _b.w - _a.w;
+    const float halfChord = 0.5f * cm_sqrt(x * x + y * y + z * z + w * w);
+    return 4.0f * cm_asin(cm_min(halfChord, 1.0f));
+}
+
+// Spherical linear interpolation
+// Note: Does not pick the shorter arc. Squad has to interpolate its control quaternions as they are,
+//  otherwise the result jumps whenever one of its slerps switches arcs. The keys are flipped into one hemisphere instead.
+static inline CameraQuat camera__path_slerp(CameraQuat _a, CameraQuat _b, float _t)
+{
+    const float cosAngle = cm_min(cm_max(camera__path_dot(_a, _b), -1.0f), 1.0f);
+
+    float wa = 1.0f - _t;
+    float wb = _t;
+
+    // Close quaternions fall back to normalized linear interpolation
+    //  Note: Opposite quaternions (no unique arc) do as well, merely to stay finite
+    if (cosAngle < 0.9995f && cosAngle > -0.9995f)
+    {
+        const float sinAngle = cm_sqrt(1.0f - cosAngle * cosAngle);
+        const float angle = cm_atan2(sinAngle, cosAngle);
+
+        float sa, ca, sb, cb;
+        cm_sincos((1.0f - _t) * angle, &sa, &ca);
+        cm_sincos(_t * angle, &sb, &cb);
+        wa = sa / sinAngle;
+        wb = sb / sinAngle;
+    }
+
+    return cm_normalizeQuat(cm_init_quat(
+        wa * _a.x + wb * _b.x,
+        wa * _a.y + wb * _b.y,
+        wa * _a.z + wb * _b.z,
+        wa * _a.w + wb * _b.w
+    ));
+}
+
+// Squad control quaternion of _q between its neighbours _previous and _next
+//  s = q * exp(-(log(q^-1 * next) + log(q^-1 * previous)) / 4)
+static inline CameraQuat camera__path_control(CameraQuat _previous, CameraQuat _q, CameraQuat _next)
+{
+    const CameraQuat inverse = camera__path_conjugate(_q);
+    const CameraQuat toNext = camera__path_log(camera__path_mul(inverse, _next));
+    const CameraQuat toPrevious = camera__path_log(camera__path_mul(inverse, _previous));
+
+    const CameraQuat tangent = cm_init_quat(
+        -0.25f * (toNext.x + toPrevious.x),
+        -0.25f * (toNext.y + toPrevious.y),
+        -0.25f * (toNext.z + toPrevious.z),
+        0.0f
+    );
+    return camera__path_mul(_q, camera__path_exp(tangent));
+}
+
+
+/* Segment evaluation */
+
+static inline CameraVec3 camera__path_position(const CameraPathSegment* _segment, float _t)
+{
+    const CameraVec3* c = _segment->position;
+    return cm_add(cm_scale(cm_add(cm_scale(cm_add(cm_scale(c[3], _t), c[2]), _t), c[1]), _t), c[0]);
+}
+
+static inline CameraPathSample camera__path_evaluate(const CameraPathSegment* _segment, float _t)
+{
+    const float* d = _segment->distance;
+
+    CameraPathSample sample;
+    sample.target_position = camera__path_position(_segment, _t);
+    sample.target_distance = ((d[3] * _t + d[2]) * _t + d[1]) * _t + d[0];
+    sample.orientation = camera__path_slerp(
+        camera__path_slerp(_segment->q0, _segment->q1, _t),
+        camera__path_slerp(_segment->s0, _segment->s1, _t),
+        2.0f * _t * (1.0f - _t)
+    );
+    return sample;
+}
+
+
+/* Path */
+
+static inline uint32_t camera__path_samples(uint32_t _samples_per_segment)
+{
+    return _samples_per_segment != 0 ? _samples_per_segment : CAMERA__PATH_DEFAULT_SAMPLES;
+}
+
+extern size_t camera_path_memory_size(uint32_t _key_count, uint32_t _samples_per_segment)
+{
+    const size_t segments = _key_count > 1 ? _key_count - 1 : 1;
+    const size_t entries = segments * camera__path_samples(_samples_per_segment) + 1;
+    return segments * sizeof(CameraPathSegment) + entries * sizeof(float);
+}
+
+extern CameraPath camera_path_init(void* _memory, const CameraPathKey* _keys, uint32_t _key_count, uint32_t _samples_per_segment)
+{
+    CameraPath path;
+    path.segment_count = _key_count > 1 ? _key_count - 1 : 1;
+    path.samples_per_segment = camera__path_samples(_samples_per_segment);
+    path.segments = (CameraPathSegment*)_memory;
+    path.arc_lengths = (float*)(path.segments + path.segment_count); // Note: Segments keep the float table aligned
+
+    const uint32_t last = _key_count - 1;
+
+    /* Segments */
+
+    // Orientations flipped into one hemisphere, so neighbours interpolate along the shorter arc
+    CameraQuat previous = _keys[0].orientation;
+    CameraQuat current = _keys[0].orientation;
+    CameraQuat next = _keys[last > 0 ? 1 : 0].orientation;
+    if (camera__path_dot(current, next) < 0.0f)
+    {
+        next = cm_init_quat(-next.x, -next.y, -next.z, -next.w);
+    }
+    CameraQuat control = camera__path_control(previous, current, next);
+
+    for (uint32_t i = 0; i < path.segment_count; ++i)
+    {
+        // Keys around the segment, the ends are repeated
+        const CameraPathKey* k0 = &_keys[i > 0 ? i - 1 : 0];
+        const CameraPathKey* k1 = &_keys[i];
+        const CameraPathKey* k2 = &_keys[i + 1 <= last ? i + 1 : last];
+        const CameraPathKey* k3 = &_keys[i + 2 <= last ? i + 2 : last];
+
+        // Uniform Catmull-Rom in polynomial form
+        CameraPathSegment* segment = &path.segments[i];
+        segment->position[0] = k1->target_position;
+        segment->position[1] = cm_scale(cm_add(k2->target_position, cm_negate(k0->target_position)), 0.5f);
+        segment->position[2] = cm_add(cm_add(k0->target_position, cm_scale(k1->target_position, -2.5f)),
+                                      cm_add(cm_scale(k2->target_position, 2.0f), cm_scale(k3->target_position, -0.5f)));
+        segment->position[3] = cm_add(cm_add(cm_scale(k0->target_position, -0.5f), cm_scale(k1->target_position, 1.5f)),
+                                      cm_add(cm_scale(k2->target_position, -1.5f), cm_scale(k3->target_position, 0.5f)));
+
+        segment->distance[0] = k1->target_distance;
+        segment->distance[1] = 0.5f * (k2->target_distance - k0->target_distance);
+        segment->distance[2] = k0->target_distance - 2.5f * k1->target_distance + 2.0f * k2->target_distance - 0.5f * k3->target_distance;
+        segment->distance[3] = -0.5f * k0->target_distance + 1.5f * k1->target_distance - 1.5f * k2->target_distance + 0.5f * k3->target_distance;
+
+        // Advance the orientation window by one key
+        previous = current;
+        current = next;
+        next = _keys[i + 2 <= last ? i + 2 : last].orientation;
+        if (camera__path_dot(current, next) < 0.0f)
+        {
+            next = cm_init_quat(-next.x, -next.y, -next.z, -next.w);
+        }
+
+        segment->q0 = previous;
+        segment->q1 = current;
+        segment->s0 = control;
+        control = camera__path_control(previous, current, next);
+        segment->s1 = control;
+    }
+
+
+    /* Arc-length table */
+
+    // Chord lengths between evenly spaced parameters of every segment
+    //  The chord spans target_position, target_distance and the rotation angle,
+    //  so a segment with a stationary target_position still gets a nonzero share of the path.
+    const uint32_t samples = path.samples_per_segment;
+    float length = 0.0f;
+    path.arc_lengths[0] = 0.0f;
+
+    for (uint32_t i = 0; i < path.segment_count; ++i)
+    {
+        CameraPathSample point = camera__path_evaluate(&path.segments[i], 0.0f);
+        for (uint32_t j = 1; j <= samples; ++j)
+        {
+            const CameraPathSample nextPoint = camera__path_evaluate(&path.segments[i], (float)j / (float)samples);
+            const CameraVec3 chord = cm_add(nextPoint.target_position, cm_negate(point.target_position));
+            const float zoom = nextPoint.target_distance - point.target_distance;
+            const float angle = camera__path_angle(point.orientation, nextPoint.orientation);
+            length += cm_sqrt(cm_dot(chord, chord) + zoom * zoom + angle * angle);
+            path.arc_lengths[i * samples + j] = length;
+            point = nextPoint;
+        }
+    }
+    path.length = length;
+
+    return path;
+}
+
+extern CameraPathCursor camera_path_cursor()
+{
+    CameraPathCursor cursor;
+    cursor.entry = 0;
+    return cursor;
+}
+
+extern CameraPathSample camera_path_sample(const CameraPath* _path, CameraPathCursor* _cursor, float _distance)
+{
+    const float* table = _path->arc_lengths;
+    const uint32_t lastEntry = _path->segment_count * _path->samples_per_segment; // Index of the final arc length
+    const float distance = cm_min(cm_max(_distance, 0.0f), _path->length);
+
+    // Walk from the previous entry, usually not more than one step per frame
+    //  Stops at the first entry whose next arc length reaches distance, so a run of equal entries
+    //  (keys without any change in between) resolves to its start from either direction.
+    uint32_t entry = _cursor->entry < lastEntry ? _cursor->entry : lastEntry - 1;
+    while (entry + 1 < lastEntry && table[entry + 1] < distance)
+    {
+        entry++;
+    }
+    while (entry > 0 && table[entry] >= distance)
+    {
+        entry--;
+    }
+    _cursor->entry = entry;
+
+    // Parameter within the segment, linear between table entries
+    const float span = table[entry + 1] - table[entry];
+    const float fraction = span > 0.0f ? cm_min((distance - table[entry]) / span, 1.0f) : 0.0f;
+
+    const uint32_t segment = entry / _path->samples_per_segment;
+    const float t = ((float)(entry % _path->samples_per_segment) + fraction) / (float)_path->samples_per_segment;
+
+    return camera__path_evaluate(&_path->segments[segment], t);
+}
+
+extern void camera_path_sample_batch(const CameraPath* _path, CameraPathCursor* _cursors, const float* _distances, uint32_t _count, CameraPathSample* _out)
+{
+    for (uint32_t i = 0; i < _count; ++i)
+    {
+        _out[i] = camera_path_sample(_path, &_cursors[i], _distances[i]);
+    }
+}
+
+extern void camera_path_apply(const CameraPathSample* _sample, Camera* _cam)
+{
+    _cam->target_position = _sample->target_position;
+    _cam->target_distance = _sample->target_distance;
+    _cam->orientation = _sample->orientation;
+}
+
+#endif // CAMERA_PATH_IMPLEMENTATION
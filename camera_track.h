@@ -0,0 +1,692 @@
+/*
+ * INFO:
+ *
+ *  This file records camera tracks for replays, repros and benchmarks and plays them back.
+ *  A track holds one CameraTrackFrame per recorded frame: the input passed to camera_move(..) and camera_rotate(..)
+ *   and the resulting target_position, target_distance and orientation.
+ *
+ *  The writer streams frames to a file. Every frame is delta coded against the previous one,
+ *   every keyframe_interval frames a keyframe is stored uncompressed. The keyframe offsets are appended on close.
+ *  The reader memory-maps the file. Sequential reads decode one frame,
+ *   random access jumps to the preceding keyframe through the index and decodes at most keyframe_interval - 1 frames.
+ *   The file is never loaded into memory as a whole.
+ *
+ *
+ * USAGE:
+ *
+ *  Include 'camera.h' first. ONE (and only ONE) source file must hold the implementation
+ *   by using '#define CAMERA_TRACK_IMPLEMENTATION' before including 'camera_track.h'.
+ *
+ *  Recording:
+ *   1. 'camera_track_writer_open(&writer, "match.camtrack", 64);'
+ *   2. Every frame:
+ *       'camera_track_capture_input(&frame, &camera);  // Before the pending input is applied'
+ *       'camera_view_matrix(&camera, view);'
+ *       'camera_track_capture_state(&frame, &camera);'
+ *       'camera_track_write(&writer, &frame);'
+ *   3. 'camera_track_writer_close(&writer);'
+ *
+ *  Playback:
+ *   1. 'camera_track_reader_open(&reader, "match.camtrack");'
+ *   2. 'camera_track_read(&reader, frame_index, &frame);'
+ *      'camera_track_apply_state(&frame, &camera);  // Or re-simulate with frame.movement and frame.rotation'
+ *   3. 'camera_track_reader_close(&reader);'
+ *
+ *
+ * FILE FORMAT:
+ *
+ *  All values are little endian.
+ *   header:   "CAMTRACK" | version (u32) | keyframe_interval (u32)
+ *   frames:   keyframe: CAMERA_TRACK_VALUES raw float bits (u32)
+ *             delta frame: CAMERA_TRACK_VALUES varints of the zigzag coded difference to the previous float bits
+ *   index:    byte offset (u64) of every keyframe
+ *   footer:   frame_count (u32) | keyframe_count (u32) | index offset (u64) | "CAMINDEX"
+ *
+ *  Subtracting the float bits keeps small changes small, unchanged values (ex. idle input) take a single byte.
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+
+#ifndef CAMERA_TRACK_HEADER_GUARD
+#define CAMERA_TRACK_HEADER_GUARD
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Track defines */
+
+// Number of floats stored per frame
+#define CAMERA_TRACK_VALUES                 14
+
+// Keyframe interval used if 0 is passed to camera_track_writer_open(..)
+#define CAMERA_TRACK_DEFAULT_KEYFRAME_INTERVAL 64
+
+// Largest encoded size (in bytes) of a frame
+#define CAMERA_TRACK_MAX_FRAME_SIZE         (CAMERA_TRACK_VALUES * 5)
+
+
+/* Track structs */
+
+// One recorded frame
+typedef struct camera_track_frame {
+    CameraVec3 movement;                // Input passed to camera_move(..) during the frame
+    CameraVec3 rotation;                // Input passed to camera_rotate(..) during the frame
+    CameraVec3 target_position;         // State after the frame was applied
+    float target_distance;
+    CameraQuat orientation;
+} CameraTrackFrame;
+
+typedef struct camera_track_writer {
+    FILE* file;
+    uint32_t keyframe_interval;
+    uint32_t frame_count;
+    uint64_t offset;                    // Bytes written so far
+    uint32_t previous[CAMERA_TRACK_VALUES]; // Float bits of the previous frame
+    uint64_t* keyframes;                // Byte offset of every keyframe
+    uint32_t keyframe_capacity;
+    bool failed;                        // Set by the first failed write, all later writes are dropped
+} CameraTrackWriter;
+
+typedef struct camera_track_reader {
+    const uint8_t* data;                // The memory-mapped file
+    size_t size;
+    uint32_t keyframe_interval;
+    uint32_t frame_count;
+    uint32_t keyframe_count;
+    size_t index_offset;
+
+    // Sequential playback, camera_track_read(..) of next_frame continues here without seeking
+    uint32_t next_frame;
+    size_t next_offset;
+    uint32_t previous[CAMERA_TRACK_VALUES];
+
+    void* mapping;                      // Platform handle of the mapping
+} CameraTrackReader;
+
+
+/* Function declarations */
+
+// Create or truncate the track file at _path and start recording
+//  A keyframe is stored every _keyframe_interval frames, 0 selects CAMERA_TRACK_DEFAULT_KEYFRAME_INTERVAL.
+//  Returns false if the file could not be opened.
+extern bool camera_track_writer_open(CameraTrackWriter* _writer, const char* _path, uint32_t _keyframe_interval);
+
+// Append a frame to the track
+//  Returns false if the frame could not be written.
+extern bool camera_track_write(CameraTrackWriter* _writer, const CameraTrackFrame* _frame);
+
+// Write the keyframe index and close the file
+//  Returns false if any write failed. The track is only readable after a successful close.
+extern bool camera_track_writer_close(CameraTrackWriter* _writer);
+
+// Store the pending input of _cam in _frame
+//  Call before camera_view_matrix(..), which consumes the input.
+// Note: with CAMERA_CONCURRENT_INPUT the input is read atomically, but input added between this call and the update
+//  is applied without being recorded. Capture and update on the input thread (or between input batches) to replay exactly.
+extern void camera_track_capture_input(CameraTrackFrame* _frame, const Camera* _cam);
+
+// Store the state of _cam in _frame
+//  Call after camera_view_matrix(..) applied the input.
+extern void camera_track_capture_state(CameraTrackFrame* _frame, const Camera* _cam);
+
+// Memory-map the track file at _path
+//  Returns false if the file could not be mapped or is not a complete track.
+extern bool camera_track_reader_open(CameraTrackReader* _reader, const char* _path);
+
+// Decode frame _frame_index into _out_frame
+//  Reading the frame after the previously read one decodes a single frame,
+//   any other frame is decoded starting from the preceding keyframe.
+//  Returns false if _frame_index is out of range or the track is corrupt.
+extern bool camera_track_read(CameraTrackReader* _reader, uint32_t _frame_index, CameraTrackFrame* _out_frame);
+
+// Unmap the track file
+extern void camera_track_reader_close(CameraTrackReader* _reader);
+
+// Overwrite target_position, target_distance and orientation of _cam with the recorded state
+//  The changes are applied by the next camera_view_matrix(..) as with any direct manipulation.
+extern void camera_track_apply_state(const CameraTrackFrame* _frame, Camera* _cam);
+
+#endif // !CAMERA_TRACK_HEADER_GUARD
+
+
+
+#ifdef CAMERA_TRACK_IMPLEMENTATION
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define CAMERA__TRACK_VERSION               1
+#define CAMERA__TRACK_HEADER_SIZE           16
+#define CAMERA__TRACK_FOOTER_SIZE           24
+
+static const char camera__track_magic[8] = { 'C', 'A', 'M', 'T', 'R', 'A', 'C', 'K' };
+static const char camera__track_index_magic[8] = { 'C', 'A', 'M', 'I', 'N', 'D', 'E', 'X' };
+
+/* Encoding */
+
+static inline uint32_t camera__track_bits(float _value)
+{
+    uint32_t bits;
+    memcpy(&bits, &_value, sizeof(bits));
+    return bits;
+}
+
+static inline float camera__track_float(uint32_t _bits)
+{
+    float value;
+    memcpy(&value, &_bits, sizeof(value));
+    return value;
+}
+
+static inline void camera__track_to_values(const CameraTrackFrame* _frame, uint32_t* _values)
+{
+    const float values[CAMERA_TRACK_VALUES] = {
+        _frame->movement.x, _frame->movement.y, _frame->movement.z,
+        _frame->rotation.x, _frame->rotation.y, _frame->rotation.z,
+        _frame->target_position.x, _frame->target_position.y, _frame->target_position.z,
+        _frame->target_distance,
+        _frame->orientation.x, _frame->orientation.y, _frame->orientation.z, _frame->orientation.w
+    };
+
+    for (uint32_t i = 0; i < CAMERA_TRACK_VALUES; ++i)
+    {
+        _values[i] = camera__track_bits(values[i]);
+    }
+}
+
+static inline void camera__track_from_values(const uint32_t* _values, CameraTrackFrame* _frame)
+{
+    float v[CAMERA_TRACK_VALUES];
+    for (uint32_t i = 0; i < CAMERA_TRACK_VALUES; ++i)
+    {
+        v[i] = camera__track_float(_values[i]);
+    }
+
+    _frame->movement = cm_init_vec3(v[0], v[1], v[2]);
+    _frame->rotation = cm_init_vec3(v[3], v[4], v[5]);
+    _frame->target_position = cm_init_vec3(v[6], v[7], v[8]);
+    _frame->target_distance = v[9];
+    _frame->orientation = cm_init_quat(v[10], v[11], v[12], v[13]);
+}
+
+static inline void camera__track_store_u32(uint8_t* _out, uint32_t _value)
+{
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        _out[i] = (uint8_t)(_value >> (8 * i));
+    }
+}
+
+static inline void camera__track_store_u64(uint8_t* _out, uint64_t _value)
+{
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        _out[i] = (uint8_t)(_value >> (8 * i));
+    }
+}
+
+static inline uint32_t camera__track_load_u32(const uint8_t* _in)
+{
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        value |= (uint32_t)_in[i] << (8 * i);
+    }
+    return value;
+}
+
+static inline uint64_t camera__track_load_u64(const uint8_t* _in)
+{
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        value |= (uint64_t)_in[i] << (8 * i);
+    }
+    return value;
+}
+
+// Encode one frame, returns the number of bytes written to _out
+//  _out is expected to hold CAMERA_TRACK_MAX_FRAME_SIZE bytes
+static inline size_t camera__track_encode(const uint32_t* _values, const uint32_t* _previous, bool _keyframe, uint8_t* _out)
+{
+    size_t size = 0;
+
+    if (_keyframe)
+    {
+        for (uint32_t i = 0; i < CAMERA_TRACK_VALUES; ++i)
+        {
+            camera__track_store_u32(_out + size, _values[i]);
+            size += 4;
+        }
+        return size;
+    }
+
+    for (uint32_t i = 0; i < CAMERA_TRACK_VALUES; ++i)
+    {
+        // Zigzag, so small negative differences stay small
+        const uint32_t delta = _values[i] - _previous[i];
+        uint32_t zigzag = (delta << 1) ^ (uint32_t)-(int32_t)(delta >> 31);
+
+        while (zigzag >= 0x80)
+        {
+            _out[size++] = (uint8_t)(zigzag | 0x80);
+            zigzag >>= 7;
+        }
+        _out[size++] = (uint8_t)zigzag;
+    }
+    return size;
+}
+
+// Decode one frame at _offset into _values, returns the offset after the frame or 0 if the data ends early
+static inline size_t camera__track_decode(const uint8_t* _data, size_t _offset, size_t _end, bool _keyframe, uint32_t* _values)
+{
+    if (_keyframe)
+    {
+        if (_end - _offset < 4 * CAMERA_TRACK_VALUES)
+        {
+            return 0;
+        }
+
+        for (uint32_t i = 0; i < CAMERA_TRACK_VALUES; ++i)
+        {
+            _values[i] = camera__track_load_u32(_data + _offset);
+            _offset += 4;
+        }
+        return _offset;
+    }
+
+    for (uint32_t i = 0; i < CAMERA_TRACK_VALUES; ++i)
+    {
+        uint32_t zigzag = 0;
+        uint32_t shift = 0;
+        for (;;)
+        {
+            if (_offset >= _end || shift > 28)
+            {
+                return 0;
+            }
+
+            const uint8_t byte = _data[_offset++];
+            zigzag |= (uint32_t)(byte & 0x7F) << shift;
+            shift += 7;
+
+            if ((byte & 0x80) == 0)
+            {
+                break;
+            }
+        }
+
+        const uint32_t delta = (zigzag >> 1) ^ (uint32_t)-(int32_t)(zigzag & 1);
+        _values[i] += delta;
+    }
+    return _offset;
+}
+
+
+/* Writer */
+
+static bool camera__track_write_bytes(CameraTrackWriter* _writer, const void* _data, size_t _size)
+{
+    if (_writer->failed || fwrite(_data, 1, _size, _writer->file) != _size)
+    {
+        _writer->failed = true;
+        return false;
+    }
+
+    _writer->offset += _size;
+    return true;
+}
+
+extern bool camera_track_writer_open(CameraTrackWriter* _writer, const char* _path, uint32_t _keyframe_interval)
+{
+    memset(_writer, 0, sizeof(*_writer));
+    _writer->keyframe_interval = _keyframe_interval != 0 ? _keyframe_interval : CAMERA_TRACK_DEFAULT_KEYFRAME_INTERVAL;
+
+    _writer->file = fopen(_path, "wb");
+    if (_writer->file == NULL)
+    {
+        return false;
+    }
+
+    uint8_t header[CAMERA__TRACK_HEADER_SIZE];
+    memcpy(header, camera__track_magic, sizeof(camera__track_magic));
+    camera__track_store_u32(header + 8, CAMERA__TRACK_VERSION);
+    camera__track_store_u32(header + 12, _writer->keyframe_interval);
+    return camera__track_write_bytes(_writer, header, sizeof(header));
+}
+
+extern bool camera_track_write(CameraTrackWriter* _writer, const CameraTrackFrame* _frame)
+{
+    if (_writer->failed || _writer->frame_count == UINT32_MAX)
+    {
+        return false;
+    }
+
+    const bool keyframe = _writer->frame_count % _writer->keyframe_interval == 0;
+
+    if (keyframe)
+    {
+        if (_writer->frame_count / _writer->keyframe_interval >= _writer->keyframe_capacity)
+        {
+            const uint32_t capacity = _writer->keyframe_capacity != 0 ? 2 * _writer->keyframe_capacity : 64;
+            uint64_t* keyframes = (uint64_t*)realloc(_writer->keyframes, capacity * sizeof(uint64_t));
+            if (keyframes == NULL)
+            {
+                _writer->failed = true;
+                return false;
+            }
+            _writer->keyframes = keyframes;
+            _writer->keyframe_capacity = capacity;
+        }
+        _writer->keyframes[_writer->frame_count / _writer->keyframe_interval] = _writer->offset;
+    }
+
+    uint32_t values[CAMERA_TRACK_VALUES];
+    camera__track_to_values(_frame, values);
+
+    uint8_t encoded[CAMERA_TRACK_MAX_FRAME_SIZE];
+    const size_t size = camera__track_encode(values, _writer->previous, keyframe, encoded);
+    if (!camera__track_write_bytes(_writer, encoded, size))
+    {
+        return false;
+    }
+
+    memcpy(_writer->previous, values, sizeof(values));
+    _writer->frame_count++;
+    return true;
+}
+
+extern bool camera_track_writer_close(CameraTrackWriter* _writer)
+{
+    if (_writer->file == NULL)
+    {
+        return false;
+    }
+
+    // Index
+    const uint64_t index_offset = _writer->offset;
+    const uint32_t keyframe_count = (_writer->frame_count + _writer->keyframe_interval - 1) / _writer->keyframe_interval;
+    for (uint32_t i = 0; i < keyframe_count; ++i)
+    {
+        uint8_t offset[8];
+        camera__track_store_u64(offset, _writer->keyframes[i]);
+        camera__track_write_bytes(_writer, offset, sizeof(offset));
+    }
+
+    // Footer
+    uint8_t footer[CAMERA__TRACK_FOOTER_SIZE];
+    camera__track_store_u32(footer, _writer->frame_count);
+    camera__track_store_u32(footer + 4, keyframe_count);
+    camera__track_store_u64(footer + 8, index_offset);
+    memcpy(footer + 16, camera__track_index_magic, sizeof(camera__track_index_magic));
+    camera__track_write_bytes(_writer, footer, sizeof(footer));
+
+    const bool closed = fclose(_writer->file) == 0;
+    free(_writer->keyframes);
+
+    const bool succeeded = closed && !_writer->failed;
+    memset(_writer, 0, sizeof(*_writer));
+    return succeeded;
+}
+
+// Read an accumulator component
+//  With CAMERA_CONCURRENT_INPUT other threads add to it atomically, so it is read with a relaxed atomic load.
+static inline float camera__track_load_input(const float* _accumulator)
+{
+#if defined(CAMERA_CONCURRENT_INPUT)
+#if defined(_MSC_VER)
+    const long bits = *(const volatile long*)_accumulator;
+    return camera__track_float((uint32_t)bits);
+#else
+    float value;
+    __atomic_load(_accumulator, &value, __ATOMIC_RELAXED);
+    return value;
+#endif
+#else
+    return *_accumulator;
+#endif
+}
+
+static inline CameraVec3 camera__track_load_inputs(const CameraVec3* _accumulator)
+{
+    const float x = camera__track_load_input(&_accumulator->x);
+    const float y = camera__track_load_input(&_accumulator->y);
+    const float z = camera__track_load_input(&_accumulator->z);
+    return cm_init_vec3(x, y, z);
+}
+
+extern void camera_track_capture_input(CameraTrackFrame* _frame, const Camera* _cam)
+{
+    _frame->movement = camera__track_load_inputs(&_cam->movement_accumulator);
+    _frame->rotation = camera__track_load_inputs(&_cam->rotation_accumulator);
+}
+
+extern void camera_track_capture_state(CameraTrackFrame* _frame, const Camera* _cam)
+{
+    _frame->target_position = _cam->target_position;
+    _frame->target_distance = _cam->target_distance;
+    _frame->orientation = _cam->orientation;
+}
+
+
+/* Reader */
+
+// Map the whole file read-only, returns false on failure
+static bool camera__track_map(CameraTrackReader* _reader, const char* _path)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file); // The mapping keeps the file open
+    if (mapping == NULL)
+    {
+        return false;
+    }
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    _reader->data = (const uint8_t*)data;
+    _reader->size = (size_t)size.QuadPart;
+    _reader->mapping = mapping;
+    return true;
+#else
+    const int file = open(_path, O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size <= 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); // The mapping keeps the file open
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    _reader->data = (const uint8_t*)data;
+    _reader->size = (size_t)info.st_size;
+    return true;
+#endif
+}
+
+static void camera__track_unmap(CameraTrackReader* _reader)
+{
+#if defined(_WIN32)
+    UnmapViewOfFile(_reader->data);
+    CloseHandle((HANDLE)_reader->mapping);
+#else
+    munmap((void*)_reader->data, _reader->size);
+#endif
+}
+
+// Byte offset of keyframe _keyframe, 0 if it is out of range
+static inline size_t camera__track_keyframe_offset(const CameraTrackReader* _reader, uint32_t _keyframe)
+{
+    const uint64_t offset = camera__track_load_u64(_reader->data + _reader->index_offset + 8 * (size_t)_keyframe);
+    if (offset < CAMERA__TRACK_HEADER_SIZE || offset >= _reader->index_offset)
+    {
+        return 0;
+    }
+    return (size_t)offset;
+}
+
+extern bool camera_track_reader_open(CameraTrackReader* _reader, const char* _path)
+{
+    memset(_reader, 0, sizeof(*_reader));
+
+    if (!camera__track_map(_reader, _path))
+    {
+        return false;
+    }
+
+    // Validate header, footer and index bounds, so reads never leave the mapping
+    const uint8_t* data = _reader->data;
+    const size_t size = _reader->size;
+    bool valid = size >= CAMERA__TRACK_HEADER_SIZE + CAMERA__TRACK_FOOTER_SIZE
+        && memcmp(data, camera__track_magic, sizeof(camera__track_magic)) == 0
+        && camera__track_load_u32(data + 8) == CAMERA__TRACK_VERSION
+        && memcmp(data + size - 8, camera__track_index_magic, sizeof(camera__track_index_magic)) == 0;
+
+    if (valid)
+    {
+        const uint8_t* footer = data + size - CAMERA__TRACK_FOOTER_SIZE;
+        _reader->keyframe_interval = camera__track_load_u32(data + 12);
+        _reader->frame_count = camera__track_load_u32(footer);
+        _reader->keyframe_count = camera__track_load_u32(footer + 4);
+        const uint64_t index_offset = camera__track_load_u64(footer + 8);
+
+        const uint64_t index_end = size - CAMERA__TRACK_FOOTER_SIZE;
+        valid = _reader->keyframe_interval != 0
+            && index_offset >= CAMERA__TRACK_HEADER_SIZE
+            && index_offset <= index_end
+            && (index_end - index_offset) / 8 == _reader->keyframe_count
+            && _reader->keyframe_count == (uint32_t)(((uint64_t)_reader->frame_count + _reader->keyframe_interval - 1) / _reader->keyframe_interval);
+        _reader->index_offset = (size_t)index_offset;
+    }
+
+    if (!valid)
+    {
+        camera__track_unmap(_reader);
+        memset(_reader, 0, sizeof(*_reader));
+        return false;
+    }
+
+    _reader->next_frame = UINT32_MAX;
+    return true;
+}
+
+extern bool camera_track_read(CameraTrackReader* _reader, uint32_t _frame_index, CameraTrackFrame* _out_frame)
+{
+    if (_frame_index >= _reader->frame_count)
+    {
+        return false;
+    }
+
+    // Seek to the preceding keyframe unless this continues sequential playback
+    if (_frame_index != _reader->next_frame)
+    {
+        const uint32_t keyframe = _frame_index / _reader->keyframe_interval;
+        _reader->next_frame = keyframe * _reader->keyframe_interval;
+        _reader->next_offset = camera__track_keyframe_offset(_reader, keyframe);
+        if (_reader->next_offset == 0)
+        {
+            _reader->next_frame = UINT32_MAX;
+            return false;
+        }
+    }
+
+    while (_reader->next_frame <= _frame_index)
+    {
+        const bool keyframe = _reader->next_frame % _reader->keyframe_interval == 0;
+        _reader->next_offset = camera__track_decode(_reader->data, _reader->next_offset, _reader->index_offset, keyframe, _reader->previous);
+        if (_reader->next_offset == 0)
+        {
+            _reader->next_frame = UINT32_MAX;
+            return false;
+        }
+        _reader->next_frame++;
+    }
+
+    camera__track_from_values(_reader->previous, _out_frame);
+    return true;
+}
+
+extern void camera_track_reader_close(CameraTrackReader* _reader)
+{
+    if (_reader->data != NULL)
+    {
+        camera__track_unmap(_reader);
+    }
+    memset(_reader, 0, sizeof(*_reader));
+}
+
+extern void camera_track_apply_state(const CameraTrackFrame* _frame, Camera* _cam)
+{
+    _cam->target_position = _frame->target_position;
+    _cam->target_distance = _frame->target_distance;
+    _cam->orientation = _frame->orientation;
+}
+
+#endif // CAMERA_TRACK_IMPLEMENTATION
@@ -0,0 +1,118 @@
+/*
+ * INFO:
+ *
+ *  Regression test for the orientation drift of camera.h
+ *
+ *  Applies millions of random rotations and checks after every update that the orientation stays within
+ *   CAMERA_NORMALIZE_EPSILON of unit length and that the cached basis stays orthonormal.
+ *  Built once per camera_math.h backend (see tests/CMakeLists.txt).
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#define CAMERA_IMPLEMENTATION
+#include "camera.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+/* Setup */
+
+static const uint32_t test_rotations = 2000000;
+
+// Drift of the orientation norm (|q|^2 - 1). The update keeps it within CAMERA_NORMALIZE_EPSILON,
+//  the slack covers the rounding of the norm itself.
+static const double test_max_norm_error = 2.0 * CAMERA_NORMALIZE_EPSILON;
+
+// Length and orthogonality error of the basis vectors
+//  The basis is derived from the orientation without normalizing, so its error follows the norm error.
+static const double test_max_basis_error = 4.0 * CAMERA_NORMALIZE_EPSILON;
+
+// Deterministic pseudo random input in [-1; 1]
+static uint32_t test_seed = 0x12345678u;
+static float test_random()
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return (float)(test_seed >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+static double test_dot(CameraVec3 _a, CameraVec3 _b)
+{
+    return (double)_a.x * _b.x + (double)_a.y * _b.y + (double)_a.z * _b.z;
+}
+
+/* Cases */
+
+// Rotate one camera test_rotations times by up to _max_angle per axis, returns the number of failed checks
+static int test_drift(const char* _case, uint32_t _mode, float _max_angle)
+{
+    Camera cam = camera_init();
+    cam.mode = _mode;
+    float matrix[16];
+
+    double worst_norm = 0.0;
+    double worst_basis = 0.0;
+    for (uint32_t i = 0; i < test_rotations; ++i)
+    {
+        camera_rotate(&cam, cm_init_vec3(test_random() * _max_angle, test_random() * _max_angle, test_random() * _max_angle));
+        camera_view_matrix(&cam, matrix);
+
+        const CameraQuat q = cam.orientation;
+        const double norm = (double)q.x * q.x + (double)q.y * q.y + (double)q.z * q.z + (double)q.w * q.w;
+        worst_norm = std::fmax(worst_norm, std::fabs(norm - 1.0));
+
+        const double basis[6] = {
+            std::sqrt(test_dot(cam.forward, cam.forward)) - 1.0,
+            std::sqrt(test_dot(cam.up, cam.up)) - 1.0,
+            std::sqrt(test_dot(cam.right, cam.right)) - 1.0,
+            test_dot(cam.forward, cam.up),
+            test_dot(cam.forward, cam.right),
+            test_dot(cam.up, cam.right),
+        };
+        for (int j = 0; j < 6; ++j)
+        {
+            worst_basis = std::fmax(worst_basis, std::fabs(basis[j]));
+        }
+    }
+
+    const bool passed = worst_norm <= test_max_norm_error && worst_basis <= test_max_basis_error;
+    std::printf("%s %s: worst |q|^2 - 1 %g (max. %g), worst basis error %g (max. %g)\n",
+        passed ? "PASS" : "FAIL", _case, worst_norm, test_max_norm_error, worst_basis, test_max_basis_error);
+    return passed ? 0 : 1;
+}
+
+int main()
+{
+    const uint32_t first_person = CAMERA_MODE_FIRST_PERSON & ~CAMERA_MODE_CLAMP_PITCH_ANGLE;
+
+    int failures = 0;
+    failures += test_drift("drift/free_small", CAMERA_MODE_FREE, 0.05f);
+    failures += test_drift("drift/free_large", CAMERA_MODE_FREE, 3.0f);
+    failures += test_drift("drift/first_person_small", first_person, 0.05f);
+    failures += test_drift("drift/first_person_large", first_person, 3.0f);
+    return failures == 0 ? 0 : 1;
+}
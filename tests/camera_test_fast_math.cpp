@@ -0,0 +1,166 @@
+/*
+ * INFO:
+ *
+ *  Regression test for the CAMERA_MATH_FAST approximations (see camera_math_fast.h)
+ *
+ *  Sweeps the approximated functions against double precision references and checks the documented error bounds,
+ *   then checks that camera_rotate(..) still rotates by exactly 45 degrees within the documented error.
+ *  Built with CAMERA_MATH_FAST once per camera_math.h backend (see tests/CMakeLists.txt).
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#if !defined(CAMERA_MATH_FAST)
+#error "camera_test_fast_math.cpp is expected to be built with CAMERA_MATH_FAST"
+#endif
+
+#define CAMERA_IMPLEMENTATION
+#include "camera.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+/* Setup */
+
+static const double test_pi = 3.14159265358979323846;
+
+// Documented bounds of camera_math_fast.h
+static const double test_max_sincos_error = 2e-7;
+static const double test_max_atan2_error = 2e-6;
+static const double test_max_asin_error = 2e-6;
+static const double test_max_rsqrt_error = 5e-7; // Relative
+static const double test_max_rotation_error = 4e-7;
+
+static const uint32_t test_samples = 1000000;
+
+// Print the result of one case, returns 1 if it failed
+static int test_report(const char* _case, double _error, double _max_error)
+{
+    const bool passed = _error <= _max_error;
+    std::printf("%s %s: worst error %g (max. %g)\n", passed ? "PASS" : "FAIL", _case, _error, _max_error);
+    return passed ? 0 : 1;
+}
+
+/* Cases */
+
+// _range is the largest magnitude of the sampled angles
+static int test_sincos(const char* _case, double _range)
+{
+    double worst = 0.0;
+    for (uint32_t i = 0; i <= test_samples; ++i)
+    {
+        const float a = (float)(-_range + 2.0 * _range * i / test_samples);
+        float s, c;
+        cm_sincos(a, &s, &c);
+        worst = std::fmax(worst, std::fabs(s - std::sin((double)a)));
+        worst = std::fmax(worst, std::fabs(c - std::cos((double)a)));
+    }
+    return test_report(_case, worst, test_max_sincos_error);
+}
+
+// Directions all around the circle at radii over many orders of magnitude
+static int test_atan2()
+{
+    double worst = 0.0;
+    for (uint32_t i = 0; i <= test_samples; ++i)
+    {
+        const double angle = -test_pi + 2.0 * test_pi * i / test_samples;
+        const double radius = std::pow(10.0, (double)(i % 13) - 6.0);
+        const float y = (float)(std::sin(angle) * radius);
+        const float x = (float)(std::cos(angle) * radius);
+        worst = std::fmax(worst, std::fabs(cm_atan2(y, x) - std::atan2((double)y, (double)x)));
+    }
+    return test_report("fast_math/atan2", worst, test_max_atan2_error);
+}
+
+static int test_asin()
+{
+    double worst = 0.0;
+    for (uint32_t i = 0; i <= test_samples; ++i)
+    {
+        const float a = (float)(-1.0 + 2.0 * i / test_samples);
+        worst = std::fmax(worst, std::fabs(cm_asin(a) - std::asin((double)a)));
+    }
+    return test_report("fast_math/asin", worst, test_max_asin_error);
+}
+
+// Logarithmic sweep over [1e-12; 1e12], which covers the squared lengths normalized by camera.h
+static int test_rsqrt()
+{
+    double worst = 0.0;
+    for (uint32_t i = 0; i <= test_samples; ++i)
+    {
+        const float a = (float)std::pow(10.0, -12.0 + 24.0 * i / test_samples);
+        const double reference = 1.0 / std::sqrt((double)a);
+        worst = std::fmax(worst, std::fabs(cm_fast_rsqrt(a) - reference) / reference);
+    }
+    return test_report("fast_math/rsqrt", worst, test_max_rsqrt_error);
+}
+
+// Rotate a camera by 45 degrees around one axis and measure the angle between its orientations before and after
+//  The camera starts at _start, so the rotation is applied on top of an arbitrary orientation.
+static int test_rotate_45(const char* _case, CameraVec3 _start, CameraVec3 _angles)
+{
+    Camera cam = camera_init();
+    float matrix[16];
+    camera_rotate(&cam, _start);
+    camera_view_matrix(&cam, matrix);
+    const CameraQuat a = cam.orientation;
+
+    camera_rotate(&cam, _angles);
+    camera_view_matrix(&cam, matrix);
+    const CameraQuat b = cam.orientation;
+
+    // conjugate(a) * b
+    const double x = (double)a.w * b.x - (double)a.x * b.w - (double)a.y * b.z + (double)a.z * b.y;
+    const double y = (double)a.w * b.y + (double)a.x * b.z - (double)a.y * b.w - (double)a.z * b.x;
+    const double z = (double)a.w * b.z - (double)a.x * b.y + (double)a.y * b.x - (double)a.z * b.w;
+    const double w = (double)a.w * b.w + (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z;
+    const double angle = 2.0 * std::atan2(std::sqrt(x * x + y * y + z * z), std::fabs(w));
+    return test_report(_case, std::fabs(angle - test_pi / 4.0), test_max_rotation_error);
+}
+
+int main()
+{
+    const float deg45 = 45.0f * (float)(test_pi / 180.0);
+    const CameraVec3 identity = cm_init_vec3(0.0f, 0.0f, 0.0f);
+    const CameraVec3 tilted = cm_init_vec3(0.3f, -1.2f, 0.7f);
+
+    int failures = 0;
+    failures += test_sincos("fast_math/sincos_small", 2.0 * test_pi);
+    failures += test_sincos("fast_math/sincos_large", 1e4);
+    failures += test_atan2();
+    failures += test_asin();
+    failures += test_rsqrt();
+    failures += test_rotate_45("fast_math/rotate_45_pitch", identity, cm_init_vec3(deg45, 0.0f, 0.0f));
+    failures += test_rotate_45("fast_math/rotate_45_yaw", identity, cm_init_vec3(0.0f, deg45, 0.0f));
+    failures += test_rotate_45("fast_math/rotate_45_roll", identity, cm_init_vec3(0.0f, 0.0f, deg45));
+    failures += test_rotate_45("fast_math/rotate_45_pitch_tilted", tilted, cm_init_vec3(deg45, 0.0f, 0.0f));
+    failures += test_rotate_45("fast_math/rotate_45_yaw_tilted", tilted, cm_init_vec3(0.0f, deg45, 0.0f));
+    failures += test_rotate_45("fast_math/rotate_45_roll_tilted", tilted, cm_init_vec3(0.0f, 0.0f, deg45));
+    return failures == 0 ? 0 : 1;
+}
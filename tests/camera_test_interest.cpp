@@ -0,0 +1,345 @@
+/*
+ * INFO:
+ *
+ *  Regression test for the interest management of camera_interest.h
+ *
+ *  Moves a few cameras of a group per frame, updates the index incrementally and checks camera_interest_visible_entities(..)
+ *   and camera_interest_point(..) against testing everything with camera_frustum(..) and camera_cull_spheres(..).
+ *  The index builds its planes from the camera basis, the brute force extracts them from the view projection, so both
+ *   differ by rounding: the index has to find everything the brute force finds a margin inside and nothing it does not
+ *   find a margin outside. The index also drops spheres outside the bounds of the frustum, which pass all planes
+ *   near its corners, so the brute force only expects spheres within the bounds. Every projection type and
+ *   configuration flag is covered. Cameras are swap-removed like camera_pool_remove(..) does, so slots change owners.
+ *  Built once per camera_math.h backend (see tests/CMakeLists.txt).
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#define CAMERA_IMPLEMENTATION
+#include "camera.h"
+#define CAMERA_INTEREST_IMPLEMENTATION
+#include "camera_interest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/* Setup */
+
+static const float test_pi = 3.14159265358979f;
+static const uint32_t test_cameras = 40;        // More than one bitset word
+static const uint32_t test_idle_camera = 37;    // Never updated, sees nothing
+static const uint32_t test_entities = 3000;
+static const uint32_t test_points = 256;
+static const uint32_t test_frames = 40;
+static const float test_world = 250.0f;         // Half size of the square the cameras and entities are spread over
+static const float test_cell_size = 32.0f;
+
+// Planes of both sides differ by rounding, results closer than this to a plane are not compared
+//  The far plane extracted from a view projection without CAMERA_PROJECTION_REVERSED_Z is off by up to ~0.02.
+static const float test_margin = 0.05f;
+
+// Deterministic pseudo random input in [-1; 1]
+static uint32_t test_seed = 0x12345678u;
+static float test_random()
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return (float)(test_seed >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+static uint32_t test_random_index(uint32_t _count)
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return (test_seed >> 8) % _count;
+}
+
+static bool test_bit(const uint32_t* _bits, uint32_t _index)
+{
+    return (_bits[_index / 32] >> (_index % 32)) & 1u;
+}
+
+// Place the camera somewhere in the world, looking in a random direction
+static void test_place(Camera* _cam)
+{
+    _cam->target_position = cm_init_vec3(test_random() * test_world, 5.0f + 5.0f * test_random(), test_random() * test_world);
+    camera_rotate(_cam, cm_init_vec3(test_random() * 0.5f, test_random() * test_pi, 0.0f));
+}
+
+// World space bounds of the frustum, from the corners of the clip volume transformed back
+static void test_bounds(const CameraMatrices& _matrices, uint32_t _flags, float* _min, float* _max)
+{
+    const float lower = (_flags & CAMERA_PROJECTION_HOMOGENEOUS_DEPTH) ? -1.0f : 0.0f;
+    const float* m = _matrices.inverse_view_projection;
+    for (int i = 0; i < 3; ++i)
+    {
+        _min[i] = 1e30f;
+        _max[i] = -1e30f;
+    }
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        const float clip[4] = { (corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : lower, 1.0f };
+        float world[4];
+        for (int j = 0; j < 4; ++j)
+        {
+            world[j] = clip[0] * m[j] + clip[1] * m[4 + j] + clip[2] * m[8 + j] + clip[3] * m[12 + j];
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            _min[i] = std::fmin(_min[i], world[i] / world[3]);
+            _max[i] = std::fmax(_max[i], world[i] / world[3]);
+        }
+    }
+}
+
+static void test_place_entity(float* _x, float* _y, float* _z)
+{
+    *_x = test_random() * test_world * 1.1f;
+    *_y = 10.0f + 10.0f * test_random();
+    *_z = test_random() * test_world * 1.1f;
+}
+
+/* Cases */
+
+// Update test_cameras cameras incrementally for test_frames and compare the queries to the brute force
+//  _bucket_count is small enough for some cases to take the paths for views spanning more cells than there are buckets.
+//  _points passes no radii, so entities are points.
+//  _swap moves the last camera into a random slot every frame instead of moving cameras. All cameras stay at
+//   generation 1 then, so the slot keeps its generation but shows another camera.
+static int test_interest(const char* _case, const CameraProjection& _proj, uint32_t _bucket_count, bool _points, bool _swap)
+{
+    std::vector<unsigned char> memory(camera_interest_memory_size(test_cameras, test_entities, _bucket_count) + CAMERA_POOL_ALIGNMENT);
+    void* aligned = (void*)(((uintptr_t)memory.data() + CAMERA_POOL_ALIGNMENT - 1) & ~(uintptr_t)(CAMERA_POOL_ALIGNMENT - 1));
+    CameraInterest interest = camera_interest_init(aligned, test_cameras, test_entities, _bucket_count, test_cell_size);
+
+    std::vector<Camera> cams(test_cameras);
+    std::vector<CameraMatrices> matrices(test_cameras);
+    std::vector<uint32_t> ids(test_cameras);          // Camera in every slot
+    std::vector<uint32_t> inserted(test_cameras, 0); // Generation every slot is expected to be inserted with
+    std::vector<uint32_t> inserted_ids(test_cameras, 0);
+    for (uint32_t k = 0; k < test_cameras; ++k)
+    {
+        ids[k] = k;
+        cams[k] = camera_init();
+        cams[k].mode = CAMERA_MODE_FIRST_PERSON;
+        test_place(&cams[k]);
+    }
+
+    std::vector<float> x(test_entities), y(test_entities), z(test_entities), radius(test_entities);
+    std::vector<float> grown(test_entities), shrunk(test_entities);
+    for (uint32_t i = 0; i < test_entities; ++i)
+    {
+        test_place_entity(&x[i], &y[i], &z[i]);
+        radius[i] = _points ? 0.0f : 1.5f + 1.5f * test_random();
+    }
+
+    std::vector<float> px(test_points), py(test_points), pz(test_points);
+    std::vector<float> point_grown(test_points, test_margin), point_shrunk(test_points, -test_margin);
+
+    // An infinite far plane has no bounds
+    const bool bounded = (_proj.flags & CAMERA_PROJECTION_ORTHOGRAPHIC) != 0 || (_proj.flags & CAMERA_PROJECTION_INFINITE_FAR) == 0;
+
+    const uint32_t words = CAMERA_INTEREST_WORDS(test_cameras);
+    const uint32_t entity_words = (test_entities + 31) / 32;
+    const uint32_t point_words = (test_points + 31) / 32;
+    std::vector<uint32_t> visible(test_entities);
+    std::vector<uint32_t> expected_grown(entity_words), expected_shrunk(entity_words);
+    std::vector<uint32_t> points_grown(test_cameras * point_words), points_shrunk(test_cameras * point_words);
+    std::vector<uint32_t> cameras(words);
+
+    uint32_t failed_frames = 0;
+    uint32_t changed = 0;
+    uint32_t found = 0;
+    uint32_t live = test_cameras;
+    for (uint32_t frame = 0; frame < test_frames; ++frame)
+    {
+        if (_swap && frame != 0 && live > 8)
+        {
+            const uint32_t k = test_random_index(live - 1);
+            live--;
+            cams[k] = cams[live];
+            matrices[k] = matrices[live];
+            ids[k] = ids[live];
+        }
+
+        // Move a few cameras, the others stay idle and keep their generation
+        for (uint32_t k = 0; k < live; ++k)
+        {
+            if (!_swap && frame != 0 && test_random() > 0.6f)
+            {
+                test_place(&cams[k]);
+            }
+            if (ids[k] != test_idle_camera)
+            {
+                camera_matrices(&cams[k], &_proj, &matrices[k]);
+            }
+        }
+
+        // Drop the last slots for one frame, they are inserted again on the next
+        const uint32_t count = frame == test_frames / 2 ? live - 5 : live;
+        uint32_t expected_changed = 0;
+        for (uint32_t k = 0; k < test_cameras; ++k)
+        {
+            const uint32_t generation = k < count ? cams[k].generation : 0;
+            expected_changed += generation != inserted[k] || (generation != 0 && ids[k] != inserted_ids[k]) ? 1 : 0;
+            inserted[k] = generation;
+            inserted_ids[k] = ids[k];
+        }
+
+        const uint32_t reported = camera_interest_update(&interest, cams.data(), count, &_proj);
+        changed += reported;
+        bool same = reported == expected_changed;
+
+        for (uint32_t i = 0; i < test_entities; ++i)
+        {
+            if (test_random() > 0.9f)
+            {
+                test_place_entity(&x[i], &y[i], &z[i]);
+            }
+            grown[i] = radius[i] + test_margin;
+            shrunk[i] = radius[i] - test_margin;
+        }
+        camera_interest_entities(&interest, x.data(), y.data(), z.data(), _points ? NULL : radius.data(), test_entities);
+
+        for (uint32_t j = 0; j < test_points; ++j)
+        {
+            px[j] = test_random() * test_world;
+            py[j] = 10.0f + 10.0f * test_random();
+            pz[j] = test_random() * test_world;
+        }
+
+        // Visible entities of every camera
+        for (uint32_t k = 0; k < test_cameras; ++k)
+        {
+            const bool active = k < count && inserted[k] != 0;
+            if (active)
+            {
+                const CameraFrustum frustum = camera_frustum(matrices[k].view_projection, _proj.flags);
+                camera_cull_spheres(&frustum, x.data(), y.data(), z.data(), grown.data(), test_entities, expected_grown.data(), NULL);
+                camera_cull_spheres(&frustum, x.data(), y.data(), z.data(), shrunk.data(), test_entities, expected_shrunk.data(), NULL);
+                camera_cull_spheres(&frustum, px.data(), py.data(), pz.data(), point_grown.data(), test_points, &points_grown[k * point_words], NULL);
+                camera_cull_spheres(&frustum, px.data(), py.data(), pz.data(), point_shrunk.data(), test_points, &points_shrunk[k * point_words], NULL);
+
+                float min[3], max[3];
+                test_bounds(matrices[k], _proj.flags, min, max);
+                for (uint32_t i = 0; i < test_entities && bounded; ++i)
+                {
+                    const float center[3] = { x[i], y[i], z[i] };
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        if (center[j] < min[j] - shrunk[i] || center[j] > max[j] + shrunk[i])
+                        {
+                            expected_shrunk[i / 32] &= ~(UINT32_C(1) << (i % 32));
+                        }
+                    }
+                }
+            }
+            else
+            {
+                for (uint32_t w = 0; w < entity_words; ++w)
+                {
+                    expected_grown[w] = 0;
+                    expected_shrunk[w] = 0;
+                }
+                for (uint32_t w = 0; w < point_words; ++w)
+                {
+                    points_grown[k * point_words + w] = 0;
+                    points_shrunk[k * point_words + w] = 0;
+                }
+            }
+
+            std::vector<uint32_t> result(entity_words, 0);
+            const uint32_t n = camera_interest_visible_entities(&interest, k, visible.data());
+            for (uint32_t e = 0; e < n; ++e)
+            {
+                same &= !test_bit(result.data(), visible[e]); // Every entity once
+                result[visible[e] / 32] |= UINT32_C(1) << (visible[e] % 32);
+            }
+            for (uint32_t w = 0; w < entity_words; ++w)
+            {
+                same &= (expected_shrunk[w] & ~result[w]) == 0 && (result[w] & ~expected_grown[w]) == 0;
+            }
+            found += n;
+        }
+
+        // Cameras seeing every point
+        for (uint32_t j = 0; j < test_points; ++j)
+        {
+            const uint32_t n = camera_interest_point(&interest, cm_init_vec3(px[j], py[j], pz[j]), cameras.data());
+            uint32_t bits = 0;
+            for (uint32_t k = 0; k < test_cameras; ++k)
+            {
+                const bool seen = test_bit(cameras.data(), k);
+                same &= !(test_bit(&points_shrunk[k * point_words], j) && !seen);
+                same &= !(seen && !test_bit(&points_grown[k * point_words], j));
+                bits += seen ? 1 : 0;
+            }
+            same &= n == bits;
+            found += n;
+        }
+
+        failed_frames += same ? 0 : 1;
+    }
+
+    // Nothing visible would pass trivially
+    const bool passed = failed_frames == 0 && found != 0;
+    std::printf("%s %s: %u of %u frames differ, %u cameras changed, %u found\n", passed ? "PASS" : "FAIL", _case,
+        failed_frames, test_frames, changed, found);
+    return passed ? 0 : 1;
+}
+
+int main()
+{
+    const float aspect = 16.0f / 9.0f;
+    const uint32_t depth_flags = CAMERA_PROJECTION_REVERSED_Z | CAMERA_PROJECTION_HOMOGENEOUS_DEPTH;
+
+    int failures = 0;
+    failures += test_interest("interest/perspective",
+        camera_projection_perspective(1.2f, aspect, 0.1f, 60.0f, 0), 1024, false, false);
+    failures += test_interest("interest/perspective_reversed_z",
+        camera_projection_perspective(1.2f, aspect, 0.1f, 60.0f, CAMERA_PROJECTION_REVERSED_Z), 1024, false, false);
+    failures += test_interest("interest/perspective_homogeneous_depth",
+        camera_projection_perspective(1.2f, aspect, 0.1f, 60.0f, CAMERA_PROJECTION_HOMOGENEOUS_DEPTH), 1024, false, false);
+    failures += test_interest("interest/perspective_infinite_far",
+        camera_projection_perspective(1.2f, aspect, 0.1f, 60.0f, CAMERA_PROJECTION_INFINITE_FAR), 1024, false, false);
+    failures += test_interest("interest/perspective_infinite_far_reversed_z_homogeneous_depth",
+        camera_projection_perspective(1.2f, aspect, 0.1f, 60.0f, CAMERA_PROJECTION_INFINITE_FAR | depth_flags), 1024, false, false);
+    failures += test_interest("interest/perspective_few_buckets",
+        camera_projection_perspective(1.2f, aspect, 0.1f, 60.0f, 0), 16, false, false);
+    failures += test_interest("interest/perspective_points",
+        camera_projection_perspective(1.2f, aspect, 0.1f, 60.0f, 0), 1024, true, false);
+    failures += test_interest("interest/orthographic",
+        camera_projection_orthographic(40.0f, aspect, 0.1f, 80.0f, 0), 1024, false, false);
+    failures += test_interest("interest/orthographic_reversed_z_homogeneous_depth",
+        camera_projection_orthographic(40.0f, aspect, 0.1f, 80.0f, depth_flags), 1024, false, false);
+    failures += test_interest("interest/orthographic_points",
+        camera_projection_orthographic(40.0f, aspect, 0.1f, 80.0f, CAMERA_PROJECTION_REVERSED_Z), 1024, true, false);
+    failures += test_interest("interest/swap_remove",
+        camera_projection_perspective(1.2f, aspect, 0.1f, 60.0f, 0), 1024, false, true);
+    failures += test_interest("interest/swap_remove_orthographic",
+        camera_projection_orthographic(40.0f, aspect, 0.1f, 80.0f, 0), 1024, false, true);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/*
+ * INFO:
+ *
+ *  Regression test for the arc-length parametrization of camera_path.h
+ *
+ *  Checks that keys with a stationary target_position (only target_distance or orientation changing)
+ *   still span distance along the path, and that the cursor walk resolves runs of equal arc lengths
+ *   to the same entry whether it walks forward or backward.
+ *  Built once per camera_math.h backend (see tests/CMakeLists.txt).
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#define CAMERA_IMPLEMENTATION
+#include "camera.h"
+#define CAMERA_PATH_IMPLEMENTATION
+#include "camera_path.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+/* Setup */
+
+static const uint32_t test_samples_per_segment = 16;
+static const uint32_t test_steps = 1000;         // Samples along the path per case
+
+// Error of the sampled state against the expected key at both ends of a path
+static const double test_max_key_error = 1e-5;
+
+// Enough for paths through up to 8 keys
+alignas(CAMERA_POOL_ALIGNMENT) static unsigned char test_memory[8 * 1024];
+
+static CameraPathKey test_key(CameraVec3 _position, float _distance, float _yaw)
+{
+    CameraPathKey key;
+    key.target_position = _position;
+    key.target_distance = _distance;
+    key.orientation = cm_fromAxisAngle(cm_init_vec3(0.0f, 1.0f, 0.0f), _yaw);
+    return key;
+}
+
+// Largest difference between a sample and a key, orientations are compared up to sign
+static double test_error(const CameraPathSample& _sample, const CameraPathKey& _key)
+{
+    const CameraVec3 p = _sample.target_position;
+    const CameraVec3 k = _key.target_position;
+    double error = std::fmax(std::fabs((double)p.x - k.x), std::fmax(std::fabs((double)p.y - k.y), std::fabs((double)p.z - k.z)));
+    error = std::fmax(error, std::fabs((double)_sample.target_distance - _key.target_distance));
+
+    const CameraQuat a = _sample.orientation;
+    const CameraQuat b = _key.orientation;
+    const double dot = (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z + (double)a.w * b.w;
+    return std::fmax(error, 1.0 - std::fabs(dot));
+}
+
+/* Cases */
+
+// A path through keys with one target_position must still run from its first to its last key
+//  _value(..) returns the component that changes along the path, which must never run backwards.
+template<typename Value>
+static int test_stationary(const char* _case, const CameraPathKey* _keys, uint32_t _key_count, Value _value)
+{
+    CameraPath path = camera_path_init(test_memory, _keys, _key_count, test_samples_per_segment);
+    CameraPathCursor cursor = camera_path_cursor();
+
+    const double start = test_error(camera_path_sample(&path, &cursor, 0.0f), _keys[0]);
+    const double end = test_error(camera_path_sample(&path, &cursor, path.length), _keys[_key_count - 1]);
+
+    cursor = camera_path_cursor();
+    bool monotonic = true;
+    double previous = _value(camera_path_sample(&path, &cursor, 0.0f));
+    for (uint32_t i = 1; i <= test_steps; ++i)
+    {
+        const double value = _value(camera_path_sample(&path, &cursor, path.length * (float)i / (float)test_steps));
+        monotonic = monotonic && value >= previous - test_max_key_error;
+        previous = value;
+    }
+
+    const bool passed = path.length > 0.0f && start <= test_max_key_error && end <= test_max_key_error && monotonic;
+    std::printf("%s %s: length %g, error at start %g, at end %g (max. %g), %s\n", passed ? "PASS" : "FAIL", _case,
+        path.length, start, end, test_max_key_error, monotonic ? "monotonic" : "not monotonic");
+    return passed ? 0 : 1;
+}
+
+// Keys that repeat long enough leave a run of equal arc lengths in the table
+//  Every distance has to resolve to the first entry whose next arc length reaches it,
+//  no matter where the cursor comes from.
+static int test_equal_entries(const char* _case, const CameraPathKey* _keys, uint32_t _key_count)
+{
+    CameraPath path = camera_path_init(test_memory, _keys, _key_count, test_samples_per_segment);
+    const uint32_t lastEntry = path.segment_count * path.samples_per_segment;
+
+    int mismatches = 0;
+    uint32_t plateaus = 0;
+    for (uint32_t i = 0; i < lastEntry; ++i)
+    {
+        plateaus += path.arc_lengths[i] == path.arc_lengths[i + 1] ? 1 : 0;
+    }
+
+    // Every table entry and the midpoints between them
+    for (uint32_t i = 0; i <= 2 * lastEntry; ++i)
+    {
+        const float distance = i % 2 == 0 ? path.arc_lengths[i / 2] : 0.5f * (path.arc_lengths[i / 2] + path.arc_lengths[i / 2 + 1]);
+
+        uint32_t expected = 0;
+        while (expected + 1 < lastEntry && path.arc_lengths[expected + 1] < distance)
+        {
+            expected++;
+        }
+
+        CameraPathCursor forward = camera_path_cursor();
+        CameraPathCursor backward = camera_path_cursor();
+        camera_path_sample(&path, &backward, path.length);
+        camera_path_sample(&path, &forward, distance);
+        camera_path_sample(&path, &backward, distance);
+        mismatches += forward.entry != expected ? 1 : 0;
+        mismatches += backward.entry != expected ? 1 : 0;
+    }
+
+    // The start of the path is the first key, not the end of the run
+    CameraPathCursor cursor = camera_path_cursor();
+    const double start = test_error(camera_path_sample(&path, &cursor, 0.0f), _keys[0]);
+
+    const bool passed = plateaus > 0 && mismatches == 0 && cursor.entry == 0 && start <= test_max_key_error;
+    std::printf("%s %s: %u equal entries, %d cursor mismatches, start entry %u, error at start %g (max. %g)\n", passed ? "PASS" : "FAIL", _case,
+        plateaus, mismatches, cursor.entry, start, test_max_key_error);
+    return passed ? 0 : 1;
+}
+
+int main()
+{
+    const CameraVec3 origin = cm_init_vec3(0.0f, 0.0f, 0.0f);
+    const float deg45 = 0.78539816f;
+
+    const CameraPathKey zoom[3] = { test_key(origin, 5.0f, 0.0f), test_key(origin, 6.0f, 0.0f), test_key(origin, 7.0f, 0.0f) };
+    const CameraPathKey turn[3] = { test_key(origin, 5.0f, 0.0f), test_key(origin, 5.0f, deg45), test_key(origin, 5.0f, 2.0f * deg45) };
+
+    const CameraVec3 a = cm_init_vec3(1.0f, 2.0f, 3.0f);
+    const CameraVec3 b = cm_init_vec3(4.0f, 2.0f, -1.0f);
+    const CameraVec3 c = cm_init_vec3(6.0f, 0.0f, 0.0f);
+    const CameraPathKey repeated_start[4] = { test_key(a, 5.0f, 0.0f), test_key(a, 5.0f, 0.0f), test_key(a, 5.0f, 0.0f), test_key(b, 6.0f, deg45) };
+    const CameraPathKey repeated_middle[6] = {
+        test_key(a, 5.0f, 0.0f), test_key(b, 6.0f, deg45), test_key(b, 6.0f, deg45),
+        test_key(b, 6.0f, deg45), test_key(b, 6.0f, deg45), test_key(c, 4.0f, 0.0f)
+    };
+
+    int failures = 0;
+    failures += test_stationary("path/stationary_zoom", zoom, 3, [](const CameraPathSample& _s) { return (double)_s.target_distance; });
+    failures += test_stationary("path/stationary_turn", turn, 3, [](const CameraPathSample& _s) { return 2.0 * std::atan2((double)_s.orientation.y, (double)_s.orientation.w); });
+    failures += test_equal_entries("path/equal_entries_start", repeated_start, 4);
+    failures += test_equal_entries("path/equal_entries_middle", repeated_middle, 6);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/*
+ * INFO:
+ *
+ *  Regression test for the camera pool of camera.h
+ *
+ *  Updates the same cameras as camera structs with camera_view_matrix(..) and in a pool with camera_view_matrix_batch(..)
+ *   and checks after every frame that both produce the same view matrices and the same camera state.
+ *  The batch only copies the members the mode of a camera uses, so every mode, smoothing, the floating origin,
+ *   direct manipulation and idle frames (early-out) are covered, as well as every CameraOutput layout.
+ *  Built once per camera_math.h backend (see tests/CMakeLists.txt).
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#define CAMERA_IMPLEMENTATION
+#include "camera.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/* Setup */
+
+static const float test_pi = 3.14159265358979f;
+static const uint32_t test_cameras = 37; // Not a multiple of CAMERA_POOL_LANES
+static const uint32_t test_frames = 2000;
+
+// Both paths run the same kernel, but it may be contracted differently where it is inlined (ex. fused multiply-add)
+static const float test_tolerance = 1e-4f;
+
+// Deterministic pseudo random input in [-1; 1]
+static uint32_t test_seed = 0x12345678u;
+static float test_random()
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return (float)(test_seed >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+static bool test_same(float _a, float _b)
+{
+    const float scale = std::fmax(1.0f, std::fmax(std::fabs(_a), std::fabs(_b)));
+    return std::fabs(_a - _b) <= test_tolerance * scale;
+}
+
+template <typename T> static bool test_same(T _a, T _b)
+{
+    return _a == _b;
+}
+
+// Batch update through camera_view_matrix_batch_output(..) with _flags into 64 byte blocks,
+//  converted back to the float[16] layout of camera_view_matrix(..)
+static void test_output(CameraPool* _pool, float* _out_matrices, uint32_t _flags)
+{
+    std::vector<unsigned char> memory(64 * (size_t)_pool->count + CAMERA_POOL_ALIGNMENT);
+    float* blocks = (float*)(((uintptr_t)memory.data() + CAMERA_POOL_ALIGNMENT - 1) & ~(uintptr_t)(CAMERA_POOL_ALIGNMENT - 1));
+    const CameraOutput output = camera_output(blocks, 64, _flags);
+    camera_view_matrix_batch_output(_pool, &output);
+
+    const bool column_major = (_flags & CAMERA_OUTPUT_COLUMN_MAJOR) != 0;
+    const bool compact = (_flags & CAMERA_OUTPUT_3X4) != 0;
+    for (uint32_t i = 0; i < _pool->count; ++i)
+    {
+        const float* block = blocks + 16 * (size_t)i;
+        float* m = _out_matrices + 16 * (size_t)i;
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                // A 3x4 drops the constant (0, 0, 0, 1) in elements 3, 7, 11 and 15
+                const bool dropped = compact && column == 3;
+                const int index = column_major ? 4 * column + row : (compact ? 3 * row + column : 4 * row + column);
+                m[4 * row + column] = dropped ? (row == 3 ? 1.0f : 0.0f) : block[index];
+            }
+        }
+    }
+}
+
+/* Cases */
+
+// Update the same cameras with and without pool for test_frames, returns the number of failed checks
+//  _update is the batch update under test, called as _update(&pool, matrices).
+template <typename Update>
+static int test_pool(const char* _case, uint32_t _mode, const CameraSmoothing* _smoothing, Update _update)
+{
+    std::vector<unsigned char> memory(camera_pool_memory_size(test_cameras) + CAMERA_POOL_ALIGNMENT);
+    void* aligned = (void*)(((uintptr_t)memory.data() + CAMERA_POOL_ALIGNMENT - 1) & ~(uintptr_t)(CAMERA_POOL_ALIGNMENT - 1));
+    CameraPool pool = camera_pool_init(aligned, test_cameras);
+
+    std::vector<Camera> cams(test_cameras);
+    for (uint32_t i = 0; i < test_cameras; ++i)
+    {
+        Camera cam = camera_init();
+        cam.mode = _mode;
+        cam.smoothing = _smoothing;
+        cam.target_distance = (_mode & CAMERA_MODE_MOVE_IN_WORLDPLANE) ? 0.0f : 5.0f;
+        cam.minPitch = -test_pi / 2.0f;
+        cam.maxPitch = test_pi / 2.0f;
+        cam.minYaw = -test_pi / 2.0f;
+        cam.maxYaw = test_pi / 2.0f;
+        cam.minRoll = -test_pi / 4.0f;
+        cam.maxRoll = test_pi / 4.0f;
+        cams[i] = cam;
+        camera_pool_add(&pool, &cam);
+    }
+
+    std::vector<float> expected(16 * (size_t)test_cameras);
+    std::vector<float> matrices(16 * (size_t)test_cameras);
+
+    uint32_t failed_frames = 0;
+    for (uint32_t frame = 0; frame < test_frames; ++frame)
+    {
+        for (uint32_t i = 0; i < test_cameras; ++i)
+        {
+            // Sparse input, so most cameras take the early-out most of the time
+            const float r = test_random();
+            if (r > 0.6f)
+            {
+                const CameraVec3 rotation = cm_init_vec3(test_random() * 0.3f, test_random() * 0.3f, test_random() * 0.3f);
+                const CameraVec3 movement = cm_init_vec3(test_random() * 300.0f, test_random() * 300.0f, test_random() * 300.0f);
+                camera_rotate(&cams[i], rotation);
+                camera_move(&cams[i], movement);
+                camera_pool_rotate(&pool, i, rotation);
+                camera_pool_move(&pool, i, movement);
+            }
+            else if (r < -0.98f)
+            {
+                // Direct manipulation of the state the batch only reads
+                const float distance = 2.0f + 4.0f * test_random();
+                cams[i].target_distance = distance;
+                pool.target_distance[i] = distance;
+                cams[i].maxYaw = test_pi / 3.0f;
+                pool.maxYaw[i] = test_pi / 3.0f;
+            }
+        }
+
+        for (uint32_t i = 0; i < test_cameras; ++i)
+        {
+            camera_view_matrix(&cams[i], &expected[16 * (size_t)i]);
+        }
+        _update(&pool, matrices.data());
+
+        bool same = true;
+        for (size_t j = 0; j < expected.size(); ++j)
+        {
+            same &= test_same(expected[j], matrices[j]);
+        }
+        for (uint32_t i = 0; i < test_cameras; ++i)
+        {
+            const Camera cam = camera_pool_get(&pool, i);
+#define TEST_COMPARE(_type, _array, _member) same &= test_same(cams[i]._member, cam._member);
+            CAMERA_POOL_FIELDS(TEST_COMPARE)
+#undef TEST_COMPARE
+        }
+        failed_frames += same ? 0 : 1;
+    }
+
+    const bool passed = failed_frames == 0;
+    std::printf("%s %s: %u of %u frames differ\n", passed ? "PASS" : "FAIL", _case, failed_frames, test_frames);
+    return passed ? 0 : 1;
+}
+
+int main()
+{
+    const CameraSmoothing smoothing = camera_smoothing(0.2f, 0.2f, 0.1f, 1.0f / 60.0f);
+    const uint32_t clamp_all = CAMERA_MODE_CLAMP_PITCH_ANGLE | CAMERA_MODE_CLAMP_YAW_ANGLE | CAMERA_MODE_CLAMP_ROLL_ANGLE;
+
+    const auto batch = [](CameraPool* _pool, float* _out) { camera_view_matrix_batch(_pool, _out); };
+
+    int failures = 0;
+    failures += test_pool("pool/free", CAMERA_MODE_FREE, NULL, batch);
+    failures += test_pool("pool/free_clamped", CAMERA_MODE_FREE | clamp_all, NULL, batch);
+    failures += test_pool("pool/first_person", CAMERA_MODE_FIRST_PERSON, NULL, batch);
+    failures += test_pool("pool/orbital", CAMERA_MODE_ORBITAL, NULL, batch);
+    failures += test_pool("pool/orbital_smoothed", CAMERA_MODE_ORBITAL, &smoothing, batch);
+    failures += test_pool("pool/floating_origin", CAMERA_MODE_FREE | CAMERA_MODE_FLOATING_ORIGIN, NULL, batch);
+    failures += test_pool("pool/floating_origin_smoothed", CAMERA_MODE_FIRST_PERSON | CAMERA_MODE_FLOATING_ORIGIN, &smoothing, batch);
+    failures += test_pool("pool/output", CAMERA_MODE_FIRST_PERSON, &smoothing,
+        [](CameraPool* _pool, float* _out) { test_output(_pool, _out, 0); });
+    failures += test_pool("pool/output_column_major", CAMERA_MODE_ORBITAL, NULL,
+        [](CameraPool* _pool, float* _out) { test_output(_pool, _out, CAMERA_OUTPUT_COLUMN_MAJOR | CAMERA_OUTPUT_STREAM); });
+    failures += test_pool("pool/output_3x4", CAMERA_MODE_FREE, NULL,
+        [](CameraPool* _pool, float* _out) { test_output(_pool, _out, CAMERA_OUTPUT_3X4); });
+    failures += test_pool("pool/output_column_major_3x4", CAMERA_MODE_FIRST_PERSON, NULL,
+        [](CameraPool* _pool, float* _out) { test_output(_pool, _out, CAMERA_OUTPUT_COLUMN_MAJOR | CAMERA_OUTPUT_3X4 | CAMERA_OUTPUT_STREAM); });
+    failures += test_pool("pool/specialized", CAMERA_MODE_FIRST_PERSON, NULL,
+        [](CameraPool* _pool, float* _out) { camera_view_matrix_batch<CAMERA_MODE_FIRST_PERSON>(_pool, _out); });
+    return failures == 0 ? 0 : 1;
+}
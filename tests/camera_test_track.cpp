@@ -0,0 +1,268 @@
+/*
+ * INFO:
+ *
+ *  Regression test for the track recording and playback of camera_track.h
+ *
+ *  Records a simulated camera with several keyframe intervals and checks that sequential and random playback
+ *   return every frame bit-exact. Truncated and corrupted files must be rejected (or decoded) without reading
+ *   outside the mapping, run the test with a sanitizer to check the latter.
+ *  Built once per camera_math.h backend (see tests/CMakeLists.txt).
+ *
+ *
+ * LICENSE:
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2022 Crydsch Cube
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#define CAMERA_IMPLEMENTATION
+#include "camera.h"
+#define CAMERA_TRACK_IMPLEMENTATION
+#include "camera_track.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* Setup */
+
+static const uint32_t test_frames = 500;
+static const uint32_t test_seeks = 2000;
+static const uint32_t test_corruptions = 500;
+
+// Track files are written next to the test executable, so backends running in parallel do not share them
+static std::string test_path;
+
+// Deterministic pseudo random input in [-1; 1]
+static uint32_t test_seed = 0x12345678u;
+static float test_random()
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return (float)(test_seed >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+static uint32_t test_random_index(uint32_t _count)
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return (test_seed >> 8) % _count;
+}
+
+// Returns true if both frames hold the same float bits
+static bool test_same(const CameraTrackFrame& _a, const CameraTrackFrame& _b)
+{
+    const float a[CAMERA_TRACK_VALUES] = {
+        _a.movement.x, _a.movement.y, _a.movement.z, _a.rotation.x, _a.rotation.y, _a.rotation.z,
+        _a.target_position.x, _a.target_position.y, _a.target_position.z, _a.target_distance,
+        _a.orientation.x, _a.orientation.y, _a.orientation.z, _a.orientation.w
+    };
+    const float b[CAMERA_TRACK_VALUES] = {
+        _b.movement.x, _b.movement.y, _b.movement.z, _b.rotation.x, _b.rotation.y, _b.rotation.z,
+        _b.target_position.x, _b.target_position.y, _b.target_position.z, _b.target_distance,
+        _b.orientation.x, _b.orientation.y, _b.orientation.z, _b.orientation.w
+    };
+    return std::memcmp(a, b, sizeof(a)) == 0;
+}
+
+// Simulate a camera for test_frames and return the recorded frames
+//  Every fourth frame is idle, so the delta coding sees unchanged values.
+static std::vector<CameraTrackFrame> test_record()
+{
+    Camera cam = camera_init();
+    cam.mode = CAMERA_MODE_FIRST_PERSON;
+    float matrix[16];
+
+    std::vector<CameraTrackFrame> frames(test_frames);
+    for (uint32_t i = 0; i < test_frames; ++i)
+    {
+        if (i % 4 != 0)
+        {
+            camera_rotate(&cam, cm_init_vec3(test_random() * 0.05f, test_random() * 0.05f, 0.0f));
+            camera_move(&cam, cm_init_vec3(test_random(), test_random(), test_random()));
+        }
+
+        camera_track_capture_input(&frames[i], &cam);
+        camera_view_matrix(&cam, matrix);
+        camera_track_capture_state(&frames[i], &cam);
+    }
+    return frames;
+}
+
+static bool test_write(const std::vector<CameraTrackFrame>& _frames, uint32_t _keyframe_interval)
+{
+    CameraTrackWriter writer;
+    bool written = camera_track_writer_open(&writer, test_path.c_str(), _keyframe_interval);
+    for (size_t i = 0; i < _frames.size() && written; ++i)
+    {
+        written = camera_track_write(&writer, &_frames[i]);
+    }
+    return camera_track_writer_close(&writer) && written;
+}
+
+static std::vector<unsigned char> test_load()
+{
+    std::vector<unsigned char> data;
+    if (FILE* file = std::fopen(test_path.c_str(), "rb"))
+    {
+        unsigned char buffer[4096];
+        size_t size;
+        while ((size = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            data.insert(data.end(), buffer, buffer + size);
+        }
+        std::fclose(file);
+    }
+    return data;
+}
+
+static void test_store(const unsigned char* _data, size_t _size)
+{
+    if (FILE* file = std::fopen(test_path.c_str(), "wb"))
+    {
+        std::fwrite(_data, 1, _size, file);
+        std::fclose(file);
+    }
+}
+
+/* Cases */
+
+// Record with _keyframe_interval and play back sequentially, in random order and past the end
+static int test_round_trip(const char* _case, const std::vector<CameraTrackFrame>& _frames, uint32_t _keyframe_interval)
+{
+    const bool written = test_write(_frames, _keyframe_interval);
+
+    CameraTrackReader reader;
+    const bool opened = written && camera_track_reader_open(&reader, test_path.c_str());
+
+    uint32_t sequential_mismatches = 0;
+    uint32_t random_mismatches = 0;
+    bool bounded = false;
+    if (opened)
+    {
+        CameraTrackFrame frame;
+        for (uint32_t i = 0; i < test_frames; ++i)
+        {
+            sequential_mismatches += camera_track_read(&reader, i, &frame) && test_same(frame, _frames[i]) ? 0 : 1;
+        }
+        for (uint32_t i = 0; i < test_seeks; ++i)
+        {
+            const uint32_t index = test_random_index(test_frames);
+            random_mismatches += camera_track_read(&reader, index, &frame) && test_same(frame, _frames[index]) ? 0 : 1;
+        }
+        bounded = !camera_track_read(&reader, test_frames, &frame) && !camera_track_read(&reader, UINT32_MAX, &frame)
+            && reader.frame_count == test_frames;
+        camera_track_reader_close(&reader);
+    }
+
+    const bool passed = opened && sequential_mismatches == 0 && random_mismatches == 0 && bounded;
+    std::printf("%s %s: %s, %u sequential and %u random mismatches, %s\n", passed ? "PASS" : "FAIL", _case,
+        opened ? "opened" : "not opened", sequential_mismatches, random_mismatches, bounded ? "bounded" : "not bounded");
+    return passed ? 0 : 1;
+}
+
+// Every truncation of a track has to be rejected on open
+static int test_truncated(const char* _case, const std::vector<CameraTrackFrame>& _frames, uint32_t _keyframe_interval)
+{
+    test_write(_frames, _keyframe_interval);
+    const std::vector<unsigned char> data = test_load();
+
+    uint32_t opened = 0;
+    for (size_t size = 0; size < data.size(); ++size)
+    {
+        test_store(data.data(), size);
+
+        CameraTrackReader reader;
+        if (camera_track_reader_open(&reader, test_path.c_str()))
+        {
+            opened++;
+            camera_track_reader_close(&reader);
+        }
+    }
+
+    const bool passed = !data.empty() && opened == 0;
+    std::printf("%s %s: %u of %zu truncations opened\n", passed ? "PASS" : "FAIL", _case, opened, data.size());
+    return passed ? 0 : 1;
+}
+
+// Tracks with a flipped bit either fail to open or play back every frame without leaving the mapping
+//  A flip in the frame data decodes to other values, which is not detectable without a checksum.
+static int test_corrupted(const char* _case, const std::vector<CameraTrackFrame>& _frames, uint32_t _keyframe_interval)
+{
+    test_write(_frames, _keyframe_interval);
+    std::vector<unsigned char> data = test_load();
+
+    uint32_t rejected = 0;
+    uint32_t failed_reads = 0;
+    for (uint32_t i = 0; i < test_corruptions && !data.empty(); ++i)
+    {
+        // Half of the flips hit the header, index and footer, which hold the offsets
+        const size_t tail = data.size() < 128 ? data.size() : 128;
+        const size_t offset = i % 2 == 0 ? test_random_index((uint32_t)data.size()) : data.size() - 1 - test_random_index((uint32_t)tail);
+        const unsigned char bit = (unsigned char)(1u << test_random_index(8));
+        data[offset] ^= bit;
+        test_store(data.data(), data.size());
+        data[offset] ^= bit;
+
+        CameraTrackReader reader;
+        if (!camera_track_reader_open(&reader, test_path.c_str()))
+        {
+            rejected++;
+            continue;
+        }
+
+        CameraTrackFrame frame;
+        for (uint32_t j = 0; j < reader.frame_count; ++j)
+        {
+            failed_reads += camera_track_read(&reader, j, &frame) ? 0 : 1;
+        }
+        for (uint32_t j = 0; j < 16; ++j)
+        {
+            failed_reads += camera_track_read(&reader, test_random_index(test_frames), &frame) ? 0 : 1;
+        }
+        camera_track_reader_close(&reader);
+    }
+
+    std::printf("PASS %s: %u of %u corruptions rejected on open, %u reads failed cleanly\n", _case,
+        rejected, test_corruptions, failed_reads);
+    return 0;
+}
+
+int main(int _argc, char** _argv)
+{
+    test_path = std::string(_argc > 0 ? _argv[0] : "camera_test_track") + ".camtrack";
+
+    const std::vector<CameraTrackFrame> frames = test_record();
+
+    int failures = 0;
+    failures += test_round_trip("track/round_trip_interval_1", frames, 1);
+    failures += test_round_trip("track/round_trip_interval_3", frames, 3);
+    failures += test_round_trip("track/round_trip_interval_64", frames, 64);
+    failures += test_round_trip("track/round_trip_default_interval", frames, 0);
+    failures += test_truncated("track/truncated_interval_3", frames, 3);
+    failures += test_truncated("track/truncated_interval_64", frames, 64);
+    failures += test_corrupted("track/corrupted_interval_3", frames, 3);
+    failures += test_corrupted("track/corrupted_interval_64", frames, 64);
+
+    std::remove(test_path.c_str());
+    return failures == 0 ? 0 : 1;
+}